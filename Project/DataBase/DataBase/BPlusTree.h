@@ -1,231 +1,305 @@
-#pragma once
-#include "Data.h"
-#include "RecordPtr.h"
-#include <set>
-#include <vector>
-
-using std::set;
-using std::vector;
-using std::pair;
-using std::ifstream;
-using std::ofstream;
-
-const size_t DEGREE = 12;
-
-class BPlusTree
-{
-	/// @brief A pair struct with Data and RecordPtr elements
-	struct Kvp
-	{
-		Data first;
-		RecordPtr second;
-
-		bool operator<(const Kvp& other) const
-		{
-			if (first < other.first)
-			{
-				return true;
-			}
-			else if (first == other.first)
-			{
-				if (second < other.second)
-					return true;
-				
-				/*if (second.rowNumber() + second.pageNumber() < other.second.rowNumber() + other.second.pageNumber())
-					return true;*/
-			}
-
-			return false;
-		}
-
-		bool operator>(const Kvp& other) const
-		{
-			if (first > other.first)
-			{
-				return true;
-			}
-			else if (first == other.first)
-			{
-				if (second > other.second)
-					return true;
-
-				/*if (second.rowNumber() + second.pageNumber() > other.second.rowNumber() + other.second.pageNumber())
-					return true;*/
-			}
-
-			return false;
-		}
-
-		bool operator==(const Kvp& other) const
-		{
-			return first == other.first && second == other.second;
-		}
-	};
-
-	/// @brief Node of the tree
-	struct Node
-	{
-		bool isLeaf;
-		vector<Kvp> keys;
-
-		Node(bool l) : isLeaf(l) {}
-	};
-
-	/// @brief The inner Node
-	struct InnerNode : public Node
-	{
-		vector<Node*> children;
-
-		InnerNode(bool l = false) 
-			: Node(l) 
-		{
-			children.reserve(DEGREE + 1);
-			for (size_t i = 0; i < DEGREE + 1; i++)
-				children.push_back(nullptr);
-		}
-
-		int getInd(const Kvp& kvp)
-		{
-			for (size_t i = 0; i < keys.size(); i++)
-				if (keys[i] == kvp)
-					return i;
-
-			return -1;
-		}
-	};
-
-	/// @brief The leaf Node
-	struct LeafNode : public Node
-	{
-		LeafNode* next;
-		LeafNode* prev;
-
-		LeafNode(bool l = true, LeafNode* n = nullptr, LeafNode* p = nullptr) 
-			: Node(l)
-			, next(n)
-			, prev(p)
-		{}
-
-		int getInd(const Data& key)
-		{
-			for (size_t i = 0; i < keys.size(); i++)
-				if (keys[i].first == key)
-					return i;
-
-			return -1;
-		}
-	};
-
-public:
-	BPlusTree(size_t deg = DEGREE) : root(nullptr), headLeaf(nullptr), tailLeaf(nullptr), degree(deg), size(0) {};
-	/// @brief Deserializing constructor
-	/// @param in - the file that the tree will be read from
-	BPlusTree(ifstream& in);
-	BPlusTree(const BPlusTree& other);
-	BPlusTree(BPlusTree&& other) noexcept;
-	BPlusTree& operator=(const BPlusTree& other);
-	BPlusTree& operator=(BPlusTree&& other) noexcept;
-	~BPlusTree() { clear(root); size = 0; headLeaf = nullptr; tailLeaf = nullptr; }
-
-	/// @brief Inserts an element into the tree
-	/// @param toAdd - the element to be inserted
-	void insert(const Kvp& toAdd);
-
-	/// @brief Searches for a Node with a given value
-	/// @param toFind - the value to be searched
-	/// @return Node with the searched value if found and nullptr otherwise
-	Node* find(const Data& toFind) const;
-
-	/// @brief Removes an element from the tree
-	/// @param toRem - the element to be removed
-	void remove(const Kvp& toRem);
-
-	/// @brief Gets a vector of elements in a given range
-	/// @param from - starting poing
-	/// @param to - ending point
-	/// @return Vector of record pointer in the range [from, to]  
-	vector<RecordPtr> getElementsInRange(const Data& from, const Data& to) const;
-
-	/// @brief Gets a set of elements in a given range
-	/// @param from - starting poing
-	/// @param to - ending point
-	/// @return Set of record pointer in the range [from, to] 
-	set<RecordPtr> getElementsInRangeInSet(const Data& from, const Data& to) const;
-
-	/// @brief Gets the element after elem
-	/// @param elem - the searched element
-	/// @return The next greater element
-	Data getNextGreaterThan(const Data& elem) const;
-
-	/// @brief Gets the element before elem
-	/// @param elem - the searched element
-	/// @return The previous lesser element
-	Data getPrevLesserThan(const Data& elem) const;
-
-	/// @brief Gets the min element in the tree
-	/// @return the min element 
-	const Data min() const { return headLeaf->keys[0].first; };
-
-	/// @brief Gets the max element in the tree
-	/// @return the max element 
-	const Data max() const { return tailLeaf->keys[tailLeaf->keys.size() - 1].first; };
-
-	inline size_t getSize() const { return size; }
-	inline bool isEmpty() const { return size == 0; }
-
-	/// @brief Saves the tree to a file in binary format
-	/// @param out - the file
-	void serialize(ofstream& out) const;
-
-private:
-	/// @brief Helper function for the destructor
-	/// @param root - root of the tree
-	void clear(Node*& root);
-
-	/// @brief Helper function for the copy constructor
-	/// @param other - the other root
-	/// @return the root of the newly copied tree
-	Node* copy(Node* other);
-
-	/// @brief Splits the cursor Node into 2 Nodes
-	/// @param cursor - the Node that will be splitted
-	/// @param toAdd - the value of the element that will be inserted
-	/// @return Node that contains half of the cursor Node
-	Node* splitChild(Node*& cursor, const Kvp& toAdd);
-
-	/// @brief Function that inserts the new element in the inner Nodes if needed
-	/// @param toAdd - the element that will be inserted
-	/// @param parent - the parent of the new Node
-	/// @param child - the new Node
-	void insertInner(const Kvp& toAdd, Node* parent, Node* child);
-
-	/// @brief Finds the parent of a given Node
-	/// @param root - the root we start searching from
-	/// @param child - the node which parent we search for
-	/// @return the parent Node of the child if found and nullptr otherwise
-	Node* findParent(Node* root, Node* child) const;
-
-	/// @brief Removes a given element up in the inner nodes of the tree
-	/// @param cursor - the Node we start removing up from
-	/// @param toDel - the element we want to be removing
-	void removeUp(Node* cursor, const Kvp& toDel);
-
-	/// @brief Gets the most left element starting from a given Node and going down
-	/// @param root - the Node we start from
-	/// @return the smallest element in a leaf Node
-	Kvp getMinElem(Node* root) const;
-
-	/// @brief Function that removes a given element from the inner Nodes if needed
-	/// @param toRem - the element to remove
-	/// @param parent - the parent of the Node that is deleted from
-	/// @param child - the Node that is deleted from
-	void removeInner(const Kvp& toRem, Node*& parent, Node*& child);
-
-private:
-	Node* root;
-	LeafNode* headLeaf;
-	LeafNode* tailLeaf;
-	size_t degree;
-	size_t size;
-};
-
+#pragma once
+#include "Data.h"
+#include "RecordPtr.h"
+#include <set>
+#include <vector>
+#include <algorithm>
+
+using std::set;
+using std::vector;
+using std::pair;
+using std::ifstream;
+using std::ofstream;
+
+const size_t NODE_BYTES = 4096; // the keys of a full Node take about one memory page
+const double BULK_FILL_FACTOR = 0.9;
+
+class BPlusTree
+{
+public:
+	/// @brief A pair struct with Data and RecordPtr elements
+	struct Kvp
+	{
+		Data first;
+		RecordPtr second;
+
+		bool operator<(const Kvp& other) const
+		{
+			int cmp = first.compare(other.first);
+			return cmp < 0 || (cmp == 0 && second < other.second);
+		}
+
+		bool operator>(const Kvp& other) const
+		{
+			int cmp = first.compare(other.first);
+			return cmp > 0 || (cmp == 0 && second > other.second);
+		}
+
+		bool operator==(const Kvp& other) const
+		{
+			return first == other.first && second == other.second;
+		}
+	};
+
+	/// @brief The default degree - as many keys as fit in NODE_BYTES (a Kvp is stored inline in the keys array)
+	static constexpr size_t DEGREE = NODE_BYTES / sizeof(Kvp);
+
+private:
+	/// @brief Node of the tree. The keys are kept sorted in a contiguous array and are searched with binary search.
+	struct Node
+	{
+		bool isLeaf;
+		vector<Kvp> keys;
+
+		Node(bool l) : isLeaf(l) {}
+		virtual ~Node() = default;
+
+		/// @brief Finds the first key that is not less than a given element
+		/// @return the index of the key or the number of keys if there is no such key
+		size_t lowerBound(const Kvp& kvp) const { return std::lower_bound(keys.begin(), keys.end(), kvp) - keys.begin(); }
+
+		/// @brief Finds the first key that is greater than a given element
+		/// @return the index of the key or the number of keys if there is no such key
+		size_t upperBound(const Kvp& kvp) const { return std::upper_bound(keys.begin(), keys.end(), kvp) - keys.begin(); }
+
+		/// @brief Finds the first key with value not less than a given value
+		/// @return the index of the key or the number of keys if there is no such key
+		size_t lowerBound(const Data& key) const
+		{
+			return std::lower_bound(keys.begin(), keys.end(), key,
+				[](const Kvp& kvp, const Data& key) { return kvp.first < key; }) - keys.begin();
+		}
+
+		/// @brief Finds the first key with value greater than a given value
+		/// @return the index of the key or the number of keys if there is no such key
+		size_t upperBound(const Data& key) const
+		{
+			return std::upper_bound(keys.begin(), keys.end(), key,
+				[](const Data& key, const Kvp& kvp) { return key < kvp.first; }) - keys.begin();
+		}
+	};
+
+	/// @brief The inner Node
+	struct InnerNode : public Node
+	{
+		vector<Node*> children;
+
+		InnerNode(size_t degree) 
+			: Node(false) 
+			, children(degree + 1, nullptr)
+		{}
+
+		int getInd(const Kvp& kvp) const
+		{
+			size_t ind = lowerBound(kvp);
+			return ind < keys.size() && keys[ind] == kvp ? ind : -1;
+		}
+	};
+
+	/// @brief The leaf Node
+	struct LeafNode : public Node
+	{
+		LeafNode* next;
+		LeafNode* prev;
+
+		LeafNode(LeafNode* n = nullptr, LeafNode* p = nullptr) 
+			: Node(true)
+			, next(n)
+			, prev(p)
+		{}
+
+		int getInd(const Data& key) const
+		{
+			size_t ind = lowerBound(key);
+			return ind < keys.size() && keys[ind].first == key ? ind : -1;
+		}
+	};
+
+public:
+	/// @brief Walks the elements of a range along the chain of leaves, one element at a time.
+	/// The elements are not copied and the cursor stays valid until the tree is modified.
+	class Cursor
+	{
+	public:
+		/// @brief Checks if the cursor points to an element
+		/// @return false if the end of the range is reached and true otherwise
+		inline bool isValid() const { return leaf != nullptr; }
+
+		const Kvp& operator*() const { return leaf->keys[ind]; }
+		const Kvp* operator->() const { return &leaf->keys[ind]; }
+
+		/// @brief Moves to the next element of the range (the previous one for a reverse cursor)
+		/// @return the cursor
+		Cursor& operator++();
+
+	private:
+		friend class BPlusTree;
+
+		Cursor(const LeafNode* leaf, size_t ind, const Data& end, bool endInclusive, bool reverse);
+
+		/// @brief Makes the cursor invalid if the current element is out of the range
+		void checkEnd();
+
+	private:
+		const LeafNode* leaf;
+		size_t ind;
+		Data end; // the last value of the range in the direction of the cursor (no value for no bound)
+		bool endInclusive;
+		bool reverse;
+	};
+
+	BPlusTree(size_t deg = DEGREE) : root(nullptr), headLeaf(nullptr), tailLeaf(nullptr), degree(deg), size(0) {};
+	/// @brief Deserializing constructor
+	/// @param in - the file that the tree will be read from
+	/// @param legacy - true if the keys are saved in the old format (with type names)
+	BPlusTree(ifstream& in, bool legacy = false);
+	BPlusTree(const BPlusTree& other);
+	BPlusTree(BPlusTree&& other) noexcept;
+	BPlusTree& operator=(const BPlusTree& other);
+	BPlusTree& operator=(BPlusTree&& other) noexcept;
+	~BPlusTree() { clear(root); size = 0; headLeaf = nullptr; tailLeaf = nullptr; }
+
+	/// @brief Inserts an element into the tree
+	/// @param toAdd - the element to be inserted
+	void insert(const Kvp& toAdd);
+
+	/// @brief Inserts many elements into the tree. The elements are sorted first and consecutive
+	/// elements that belong to the same leaf are added to it without descending from the root again.
+	/// @param batch - the elements to be inserted
+	void insertBatch(vector<Kvp> batch);
+
+	/// @brief Replaces the content of the tree with the given elements building it bottom-up:
+	/// the leaves are packed to the fill factor and every inner level is built from the one below it
+	/// @param elements - the elements of the new tree (they are sorted first if they aren't)
+	/// @param fillFactor - the part of every Node that will be filled
+	void bulkLoad(vector<Kvp> elements, double fillFactor = BULK_FILL_FACTOR);
+
+	/// @brief Searches for a Node with a given value
+	/// @param toFind - the value to be searched
+	/// @return Node with the searched value if found and nullptr otherwise
+	Node* find(const Data& toFind) const;
+
+	/// @brief Removes an element from the tree
+	/// @param toRem - the element to be removed
+	void remove(const Kvp& toRem);
+
+	/// @brief Gets a vector of elements in a given range
+	/// @param from - starting poing
+	/// @param to - ending point
+	/// @return Vector of record pointer in the range [from, to]  
+	vector<RecordPtr> getElementsInRange(const Data& from, const Data& to) const;
+
+	/// @brief Gets a set of elements in a given range
+	/// @param from - starting poing
+	/// @param to - ending point
+	/// @return Set of record pointer in the range [from, to] 
+	set<RecordPtr> getElementsInRangeInSet(const Data& from, const Data& to) const;
+
+	/// @brief Gets a cursor over the elements with values in a given range, sorted by value
+	/// @param from - the lower bound (no value for no lower bound)
+	/// @param to - the upper bound (no value for no upper bound)
+	/// @param fromInclusive - false if the elements equal to the lower bound are left out
+	/// @param toInclusive - false if the elements equal to the upper bound are left out
+	/// @param reverse - true if the elements are walked from the upper bound down to the lower one
+	/// @return cursor to the first element of the range
+	Cursor range(const Data& from = Data(), const Data& to = Data(),
+		bool fromInclusive = true, bool toInclusive = true, bool reverse = false) const;
+
+	/// @brief Gets the element after elem
+	/// @param elem - the searched element
+	/// @return The next greater element
+	Data getNextGreaterThan(const Data& elem) const;
+
+	/// @brief Gets the element before elem
+	/// @param elem - the searched element
+	/// @return The previous lesser element
+	Data getPrevLesserThan(const Data& elem) const;
+
+	/// @brief Gets the min element in the tree
+	/// @return the min element 
+	const Data min() const { return headLeaf->keys[0].first; };
+
+	/// @brief Gets the max element in the tree
+	/// @return the max element 
+	const Data max() const { return tailLeaf->keys[tailLeaf->keys.size() - 1].first; };
+
+	inline size_t getSize() const { return size; }
+	inline bool isEmpty() const { return size == 0; }
+
+	/// @brief Saves the tree to a file in binary format
+	/// @param out - the file
+	void serialize(ofstream& out) const;
+
+private:
+	/// @brief Helper function for the destructor
+	/// @param root - root of the tree
+	void clear(Node*& root);
+
+	/// @brief Helper function for the copy constructor
+	/// @param other - the other root
+	/// @return the root of the newly copied tree
+	Node* copy(Node* other);
+
+	/// @brief Splits a number of elements into groups of almost equal sizes
+	/// @param count - the number of elements
+	/// @param maxSize - the maximum size of a group
+	/// @param minSize - the minimum size of a group
+	/// @return the number of groups
+	size_t groupsCount(size_t count, size_t maxSize, size_t minSize) const;
+
+	/// @brief Finds the first element with value not less than a given value
+	/// @param key - the value
+	/// @param ind - set to the index of the element in the returned leaf
+	/// @return the leaf of the element or nullptr if all elements are less than the value
+	LeafNode* lowerBound(const Data& key, size_t& ind) const;
+
+	/// @brief Finds the first element with value greater than a given value
+	/// @param key - the value
+	/// @param ind - set to the index of the element in the returned leaf
+	/// @return the leaf of the element or nullptr if no element is greater than the value
+	LeafNode* upperBound(const Data& key, size_t& ind) const;
+
+	/// @brief Finds the leaf in which a given element should be
+	/// @param kvp - the element
+	/// @param upperBound - the smallest key in the inner Nodes on the path that is greater than the element (the leaf can hold only elements less than it)
+	/// @param hasUpperBound - false if there is no such key (the leaf is the rightmost one)
+	/// @return the leaf Node
+	LeafNode* findLeaf(const Kvp& kvp, Kvp& upperBound, bool& hasUpperBound) const;
+
+	/// @brief Splits the cursor Node into 2 Nodes
+	/// @param cursor - the Node that will be splitted
+	/// @param toAdd - the value of the element that will be inserted
+	/// @return Node that contains half of the cursor Node
+	Node* splitChild(Node*& cursor, const Kvp& toAdd);
+
+	/// @brief Function that inserts the new element in the inner Nodes if needed
+	/// @param toAdd - the element that will be inserted
+	/// @param path - the inner Nodes from the root to the parent of the new Node (the Nodes that are split are popped)
+	/// @param child - the new Node
+	void insertInner(const Kvp& toAdd, vector<Node*>& path, Node* child);
+
+	/// @brief Removes a given element up in the inner nodes of the tree
+	/// @param path - the inner Nodes from the root to the leaf the element was removed from
+	/// @param toDel - the element we want to be removing
+	void removeUp(const vector<Node*>& path, const Kvp& toDel);
+
+	/// @brief Gets the most left element starting from a given Node and going down
+	/// @param root - the Node we start from
+	/// @return the smallest element in a leaf Node
+	Kvp getMinElem(Node* root) const;
+
+	/// @brief Function that removes a given element from the inner Nodes if needed
+	/// @param toRem - the element to remove
+	/// @param path - the inner Nodes from the root to the leaf (updated when Nodes on it are merged or the root is removed)
+	/// @param level - the index in the path of the parent of the Node that is deleted from
+	/// @param child - the Node that is deleted from (the caller deletes it after the call)
+	void removeInner(const Kvp& toRem, vector<Node*>& path, size_t level, Node* child);
+
+private:
+	Node* root;
+	LeafNode* headLeaf;
+	LeafNode* tailLeaf;
+	size_t degree;
+	size_t size;
+};
+
@@ -0,0 +1,72 @@
+#include "BloomFilter.h"
+#include <algorithm>
+
+BloomFilter::BloomFilter(size_t keys, size_t bitsPerKey)
+	: words((keys * bitsPerKey + 63) / 64, 0)
+	, hashes(std::max<uint32_t>(1, (uint32_t)(bitsPerKey * 69 / 100))) // bitsPerKey * ln(2) gives the fewest false positives
+{}
+
+BloomFilter::BloomFilter(std::ifstream& in)
+{
+	size_t len;
+	in.read((char*)&len, sizeof(len));
+	in.read((char*)&hashes, sizeof(hashes));
+
+	words.resize(len);
+	if (len > 0)
+		in.read((char*)&words[0], len * sizeof(uint64_t));
+}
+
+void BloomFilter::add(const Data& value)
+{
+	if (!isEnabled())
+		return;
+
+	// double hashing - the i-th bit is h1 + i * h2, both taken from one 64-bit hash
+	uint64_t hash = value.foldedHash();
+	uint64_t h1 = hash & 0xFFFFFFFF;
+	uint64_t h2 = (hash >> 32) | 1;
+	uint64_t bits = words.size() * 64;
+
+	for (uint32_t i = 0; i < hashes; i++)
+	{
+		uint64_t bit = (h1 + i * h2) % bits;
+		words[bit / 64] |= uint64_t(1) << (bit % 64);
+	}
+}
+
+bool BloomFilter::mayContain(const Data& value) const
+{
+	if (!isEnabled())
+		return true;
+
+	uint64_t hash = value.foldedHash();
+	uint64_t h1 = hash & 0xFFFFFFFF;
+	uint64_t h2 = (hash >> 32) | 1;
+	uint64_t bits = words.size() * 64;
+
+	for (uint32_t i = 0; i < hashes; i++)
+	{
+		uint64_t bit = (h1 + i * h2) % bits;
+		if (!(words[bit / 64] >> (bit % 64) & 1))
+			return false;
+	}
+
+	return true;
+}
+
+void BloomFilter::clear()
+{
+	std::fill(words.begin(), words.end(), 0);
+}
+
+void BloomFilter::serialize(std::ofstream& out) const
+{
+	size_t len = words.size();
+	out.write((const char*)&len, sizeof(len));
+	out.write((const char*)&hashes, sizeof(hashes));
+
+	if (len > 0)
+		out.write((const char*)&words[0], len * sizeof(uint64_t));
+}
+
@@ -0,0 +1,52 @@
+#pragma once
+#include "Data.h"
+#include <fstream>
+#include <vector>
+
+using std::vector;
+
+const size_t DEFAULT_BLOOM_BITS_PER_KEY = 10; // about 1% false positives
+const size_t MAX_BLOOM_BITS_PER_KEY = 64;
+
+/// @brief A Bloom filter of the values of one column of one page. It answers if a value may be in the page -
+/// a value that was added is always found, and a value that wasn't is found only with a small probability
+/// (a false positive), which depends on the bits per value. A String is hashed by its lowercase characters,
+/// because the strings are compared without the case of the letters.
+
+class BloomFilter
+{
+public:
+	/// @brief Creates a filter (a filter with no bits is disabled and finds every value)
+	/// @param keys - the max number of values that will be added
+	/// @param bitsPerKey - the bits of the filter for every value
+	BloomFilter(size_t keys = 0, size_t bitsPerKey = DEFAULT_BLOOM_BITS_PER_KEY);
+
+	/// @brief Deserializing constructor
+	/// @param in - the file that the object will be read from
+	BloomFilter(std::ifstream& in);
+
+	/// @brief Adds a value to the filter
+	/// @param value - the value
+	void add(const Data& value);
+
+	/// @brief Checks if a value may have been added to the filter
+	/// @param value - the value
+	/// @return false if the value surely wasn't added and true otherwise
+	bool mayContain(const Data& value) const;
+
+	/// @brief Removes all values from the filter, keeping its size
+	void clear();
+
+	/// @brief Checks if the filter has bits
+	/// @return false if the filter finds every value and true otherwise
+	inline bool isEnabled() const { return !words.empty(); }
+
+	/// @brief Saves the filter to a file in binary format
+	/// @param out - the file
+	void serialize(std::ofstream& out) const;
+
+private:
+	vector<uint64_t> words;
+	uint32_t hashes; // the number of bits set for every value
+};
+
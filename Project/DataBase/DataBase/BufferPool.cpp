@@ -0,0 +1,283 @@
+#include "BufferPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+BufferPool::~BufferPool()
+{
+	try
+	{
+		flushAll();
+	}
+	catch (...)
+	{
+	}
+}
+
+BufferPool& BufferPool::i()
+{
+	static BufferPool pool;
+	return pool;
+}
+
+Page& BufferPool::getPage(const string& table, size_t pageNumber)
+{
+	PageId id{ table, pageNumber };
+
+	auto it = framesHT.find(id);
+	if (it != framesHT.end())
+	{
+		// move the page to the front as the most recently used
+		frames.splice(frames.begin(), frames, it->second);
+		return it->second->page;
+	}
+
+	Page page = readPage(id);
+
+	makeSpace();
+	frames.push_front({ id, std::move(page), false });
+	framesHT[id] = frames.begin();
+
+	return frames.front().page;
+}
+
+Page& BufferPool::putPage(const string& table, size_t pageNumber, const Page& page)
+{
+	PageId id{ table, pageNumber };
+
+	auto it = framesHT.find(id);
+	if (it != framesHT.end())
+	{
+		it->second->page = page;
+		it->second->dirty = true;
+		frames.splice(frames.begin(), frames, it->second);
+		return it->second->page;
+	}
+
+	makeSpace();
+	frames.push_front({ id, page, true });
+	framesHT[id] = frames.begin();
+
+	return frames.front().page;
+}
+
+void BufferPool::markDirty(const string& table, size_t pageNumber)
+{
+	auto it = framesHT.find({ table, pageNumber });
+	if (it == framesHT.end())
+		throw std::exception("Page isn't in the buffer pool!");
+
+	it->second->dirty = true;
+}
+
+void BufferPool::flush(const string& table)
+{
+	for (Frame& frame : frames)
+	{
+		if (frame.dirty && frame.id.table == table)
+			writePage(frame);
+	}
+
+	auto it = segments.find(table);
+	if (it != segments.end())
+		it->second.file.flush();
+}
+
+void BufferPool::flushAll()
+{
+	for (Frame& frame : frames)
+	{
+		if (frame.dirty)
+			writePage(frame);
+	}
+
+	for (auto& segment : segments)
+		segment.second.file.flush();
+}
+
+void BufferPool::discard(const string& table)
+{
+	for (list<Frame>::iterator it = frames.begin(); it != frames.end();)
+	{
+		if (it->id.table == table)
+		{
+			framesHT.erase(it->id);
+			it = frames.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void BufferPool::setCapacity(size_t pages)
+{
+	if (pages == 0)
+		throw std::invalid_argument("Buffer pool capacity must be positive!");
+
+	capacity = pages;
+	while (frames.size() > capacity)
+		evict();
+}
+
+void BufferPool::createSegment(const string& table, size_t pageSize)
+{
+	closeSegment(table);
+
+	Segment& segment = segments[table];
+	segment.pageSize = pageSize;
+	segment.file.open(segmentName(table), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!segment.file)
+	{
+		segments.erase(table);
+		throw std::exception("Couldn't create segment file!");
+	}
+}
+
+void BufferPool::openSegment(const string& table, size_t pageSize)
+{
+	segments.erase(table);
+
+	Segment& segment = segments[table];
+	segment.pageSize = pageSize;
+	segment.file.open(segmentName(table), std::ios::in | std::ios::out | std::ios::binary);
+	if (!segment.file)
+	{
+		// a table that was never saved has no segment yet
+		segment.file.clear();
+		segment.file.open(segmentName(table), std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+	}
+	if (!segment.file)
+	{
+		segments.erase(table);
+		throw std::exception("Couldn't open segment file!");
+	}
+}
+
+size_t BufferPool::importPages(const string& table, size_t pageCount, size_t pageSize)
+{
+	// the old pages had no size limit, so the pages are read once to find the biggest one
+	std::vector<size_t> oldPages;
+	for (size_t i = 1; i <= pageCount; i++)
+	{
+		std::ifstream in(pageFileName(table, i), std::ios::binary);
+		if (!in)
+			continue;
+
+		bool converted;
+		pageSize = std::max(pageSize, Page::load(in, converted).getPageSize());
+		oldPages.push_back(i);
+	}
+
+	openSegment(table, pageSize);
+	Segment& segment = segments.at(table);
+
+	for (size_t i : oldPages)
+	{
+		std::ifstream in(pageFileName(table, i), std::ios::binary);
+		bool converted;
+		Page page = Page::load(in, converted);
+		in.close();
+
+		segment.file.seekp((i - 1) * pageSize);
+		page.serialize(segment.file);
+	}
+
+	segment.file.flush();
+	if (!segment.file)
+		throw std::exception("Couldn't write segment file!");
+
+	// the old files are removed only after all pages are in the segment
+	for (size_t i : oldPages)
+		std::remove(pageFileName(table, i).c_str());
+
+	return pageSize;
+}
+
+void BufferPool::replaceSegment(const string& table, const string& source)
+{
+	flush(source);
+	size_t pageSize = getSegment(source).pageSize;
+	closeSegment(source);
+	closeSegment(table);
+
+	// replaces the old file if there is one
+	std::error_code error;
+	std::filesystem::rename(segmentName(source), segmentName(table), error);
+	openSegment(table, pageSize);
+	if (error)
+		throw std::exception("Couldn't replace segment file!");
+}
+
+void BufferPool::closeSegment(const string& table)
+{
+	discard(table);
+	segments.erase(table);
+}
+
+void BufferPool::dropSegment(const string& table)
+{
+	closeSegment(table);
+	std::remove(segmentName(table).c_str());
+}
+
+string BufferPool::segmentName(const string& table) const
+{
+	return table + "_pages.bin";
+}
+
+string BufferPool::pageFileName(const string& table, size_t pageNumber) const
+{
+	return table + "_page" + std::to_string(pageNumber) + ".bin";
+}
+
+BufferPool::Segment& BufferPool::getSegment(const string& table)
+{
+	if (segments.find(table) == segments.end())
+		openSegment(table, PAGE_SIZE);
+
+	return segments.at(table);
+}
+
+Page BufferPool::readPage(const PageId& id)
+{
+	Segment& segment = getSegment(id.table);
+
+	// a failed read of a missing page leaves the stream in a fail state
+	segment.file.clear();
+	segment.file.seekg((id.pageNumber - 1) * segment.pageSize);
+	if (id.pageNumber == 0 || !segment.file)
+		throw std::exception("Couldn't read page!");
+
+	return Page(segment.file);
+}
+
+void BufferPool::writePage(Frame& frame)
+{
+	Segment& segment = getSegment(frame.id.table);
+	if (frame.page.getPageSize() > segment.pageSize)
+		throw std::exception("Page doesn't fit in the segment file!");
+
+	segment.file.clear();
+	segment.file.seekp((frame.id.pageNumber - 1) * segment.pageSize);
+	frame.page.serialize(segment.file);
+	if (!segment.file)
+		throw std::exception("Couldn't write page!");
+
+	frame.dirty = false;
+}
+
+void BufferPool::evict()
+{
+	Frame& victim = frames.back();
+	if (victim.dirty)
+		writePage(victim);
+
+	framesHT.erase(victim.id);
+	frames.pop_back();
+}
+
+void BufferPool::makeSpace()
+{
+	while (frames.size() >= capacity)
+		evict();
+}
@@ -0,0 +1,174 @@
+#pragma once
+#include <fstream>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "Page.h"
+
+using std::list;
+using std::string;
+using std::unordered_map;
+
+const size_t DEFAULT_POOL_CAPACITY = 256;
+
+/// @brief A bounded cache of the pages of all tables. Pages are kept in memory in LRU order,
+/// modified pages are marked dirty and written back to their file when evicted or flushed.
+/// All pages of a table are in one segment file that stays open - page N is at offset (N - 1) * page size.
+
+class BufferPool
+{
+	/// @brief Identifies a page - the name of the table it belongs to and its number
+	struct PageId
+	{
+		string table;
+		size_t pageNumber;
+
+		bool operator==(const PageId& other) const
+		{
+			return pageNumber == other.pageNumber && table == other.table;
+		}
+	};
+
+	struct PageIdHash
+	{
+		size_t operator()(const PageId& id) const
+		{
+			return std::hash<string>()(id.table) ^ (std::hash<size_t>()(id.pageNumber) << 1);
+		}
+	};
+
+	/// @brief A cached page
+	struct Frame
+	{
+		PageId id;
+		Page page;
+		bool dirty;
+	};
+
+	/// @brief The open segment file of a table
+	struct Segment
+	{
+		std::fstream file;
+		size_t pageSize;
+	};
+
+public:
+	BufferPool(const BufferPool& other) = delete;
+	BufferPool& operator=(const BufferPool& other) = delete;
+	~BufferPool();
+
+	static BufferPool& i();
+
+	/// @brief Gets a page from the cache and reads it from its file if it isn't cached.
+	/// The reference is valid until the next call that may evict pages.
+	/// @param table - the name of the table
+	/// @param pageNumber - the number of the page
+	/// @return the cached page
+	Page& getPage(const string& table, size_t pageNumber);
+
+	/// @brief Puts a new page in the cache (replacing the cached one if there is such) and marks it dirty
+	/// @param table - the name of the table
+	/// @param pageNumber - the number of the page
+	/// @param page - the page
+	/// @return the cached page
+	Page& putPage(const string& table, size_t pageNumber, const Page& page);
+
+	/// @brief Marks a cached page as modified so it will be written back to its file
+	/// @param table - the name of the table
+	/// @param pageNumber - the number of the page
+	void markDirty(const string& table, size_t pageNumber);
+
+	/// @brief Writes all modified pages of a table to their files
+	/// @param table - the name of the table
+	void flush(const string& table);
+
+	/// @brief Writes all modified pages to their files
+	void flushAll();
+
+	/// @brief Removes all pages of a table from the cache without writing them
+	/// @param table - the name of the table
+	void discard(const string& table);
+
+	/// @brief Creates an empty segment file for a new table (replacing an old one with the same name)
+	/// @param table - the name of the table
+	/// @param pageSize - the size of the pages of the table
+	void createSegment(const string& table, size_t pageSize);
+
+	/// @brief Opens the segment file of a table
+	/// @param table - the name of the table
+	/// @param pageSize - the size of the pages of the table
+	void openSegment(const string& table, size_t pageSize);
+
+	/// @brief Moves the pages of a table from a file per page (the old format) to the segment file of the table,
+	/// converting them if needed. The old files are removed, so pages that have no file are left as they are.
+	/// @param table - the name of the table
+	/// @param pageCount - the number of pages of the table
+	/// @param pageSize - the size of the pages of the table
+	/// @return the size of the pages in the segment (bigger than pageSize if an old page didn't fit)
+	size_t importPages(const string& table, size_t pageCount, size_t pageSize);
+
+	/// @brief Writes the pages of a source segment and moves its file over the segment file of a table,
+	/// so the old pages of the table stay in their file until the new ones are complete
+	/// @param table - the name of the table
+	/// @param source - the name of the segment with the new pages (closed after the move)
+	void replaceSegment(const string& table, const string& source);
+
+	/// @brief Discards the pages of a table and closes its segment file
+	/// @param table - the name of the table
+	void closeSegment(const string& table);
+
+	/// @brief Discards the pages of a table, closes its segment file and deletes it
+	/// @param table - the name of the table
+	void dropSegment(const string& table);
+
+	/// @brief Sets the maximum ammount of cached pages, evicting pages if needed
+	/// @param pages - the new capacity
+	void setCapacity(size_t pages);
+
+	inline size_t getCapacity() const { return capacity; }
+
+	/// @brief Gets the ammount of cached pages
+	/// @return the size of the cache
+	inline size_t size() const { return frames.size(); }
+
+private:
+	BufferPool() : capacity(DEFAULT_POOL_CAPACITY) {};
+
+	/// @brief Gives the name of the segment file of a table
+	/// @param table - the name of the table
+	/// @return the name of the file
+	string segmentName(const string& table) const;
+
+	/// @brief Gives the name of the file of a page saved in the old format (a file per page)
+	/// @param table - the name of the table
+	/// @param pageNumber - the number of the page
+	/// @return the name of the file
+	string pageFileName(const string& table, size_t pageNumber) const;
+
+	/// @brief Gets the open segment file of a table, opening it with the default page size if it isn't open
+	/// @param table - the name of the table
+	/// @return the segment
+	Segment& getSegment(const string& table);
+
+	/// @brief Reads a page from the segment file of its table
+	/// @param id - the page
+	/// @return the read page
+	Page readPage(const PageId& id);
+
+	/// @brief Writes a page to the segment file of its table
+	/// @param frame - the cached page
+	void writePage(Frame& frame);
+
+	/// @brief Removes the least recently used page from the cache, writing it back if it is dirty
+	void evict();
+
+	/// @brief Evicts the least recently used pages until there is space for one more page
+	void makeSpace();
+
+private:
+	size_t capacity;
+	list<Frame> frames; // the most recently used page is at the front
+	unordered_map<PageId, list<Frame>::iterator, PageIdHash> framesHT;
+	unordered_map<string, Segment> segments;
+};
+
@@ -1,194 +1,744 @@
-#include "Data.h"
-
-Data::Data()
-	: value(nullptr)
-{}
-
-Data::Data(int val)
-{
-	setValue(val);
-}
-
-Data::Data(double val)
-{
-	setValue(val);
-}
-
-Data::Data(const std::string& val)
-{
-	setValue(val);
-}
-
-Data::Data(std::ifstream& in)
-{
-	std::string type;
-	size_t len = type.length();
-	in.read((char*)&len, sizeof(len));
-	type.resize(len);
-	in.read((char*)&type[0], len);
-
-	if (type == "Int")
-		value = new Integer();
-	else if (type == "Double")
-		value = new Double();
-	else if (type == "String")
-		value = new String();
-	else if (type == "DateTime")
-		value = new DateTime();
-
-	value->deserialize(in);
-}
-
-Data::Data(const Data& other)
-{
-	copy(other);
-}
-
-Data& Data::operator=(const Data& other)
-{
-	if (this != &other)
-	{
-		clear();
-		copy(other);
-	}
-	return *this;
-}
-
-Data::~Data()
-{
-	clear();
-}
-
-void Data::serialize(std::ofstream& out) const
-{
-	std::string type;
-
-	if (typeid(*value) == typeid(Integer))
-		type = "Int";
-	else if (typeid(*value) == typeid(Double))
-		type = "Double";
-	else if (typeid(*value) == typeid(String))
-		type = "String";
-	else if (typeid(*value) == typeid(DateTime))
-		type = "DateTime";
-
-	size_t len = type.length();
-	out.write((const char*)&len, sizeof(len));
-	out.write((const char*)&type[0], len);
-
-	value->serialize(out);
-}
-
-bool Data::operator<(const Data& other) const
-{
-	return value->operator<(*other.value);
-}
-
-bool Data::operator<=(const Data& other) const
-{
-	return value->operator<(*other.value) || value->operator==(*other.value);
-}
-
-bool Data::operator>(const Data& other) const
-{
-	return value->operator>(*other.value);
-}
-
-bool Data::operator>=(const Data& other) const
-{
-	return value->operator>(*other.value) || value->operator==(*other.value);
-}
-
-bool Data::operator==(const Data& other) const
-{
-	return value->operator==(*other.value);
-}
-
-bool Data::operator!=(const Data& other) const
-{
-	return value->operator!=(*other.value);
-}
-
-std::string Data::toString() const
-{
-	return value->toString();
-}
-
-void Data::setValue(int val)
-{
-	value = new Integer(val);
-}
-
-void Data::setValue(double val)
-{
-	value = new Double(val);
-}
-
-void Data::setValue(const std::string& val)
-{
-	if (isDateTime(val))
-		value = new DateTime(val);
-	else
-		value = new String(val);
-}
-
-void Data::copy(const Data& other)
-{
-	value = other.value == nullptr ? nullptr : other.value->clone();
-}
-
-void Data::clear()
-{
-	delete value;
-	value = nullptr;
-}
-
-bool Data::isDateTime(const std::string& str) const
-{
-	std::string day, month, year;
-
-	if (str.size() < 5)
-		return false;
-
-	size_t pipes = 0;
-	for (size_t i = 0; i < str.size(); i++)
-	{
-		if (str[i] == '-')
-			pipes++;
-	}
-	if (pipes != 2)
-		return false;
-
-	size_t ind = 0;
-
-	while (ind < str.size() && str[ind] != '-')
-	{
-		day += str[ind];
-		ind++;
-	}
-	ind++;
-
-	if (day.size() < 1 || day.size() > 2)
-		return false;
-
-	while (ind < str.size() && str[ind] != '-')
-	{
-		month += str[ind];
-		ind++;
-	}
-	ind++;
-
-	if (month.size() < 1 || month.size() > 2)
-		return false;
-
-	while (ind < str.size())
-	{
-		year += str[ind];
-		ind++;
-	}
-
-	if (year.size() < 1 || year.size() > 4)
-		return false;
-
-	return true;
-}
+#include "Data.h"
+#include <cstring>
+#include <vector>
+
+Data::Data()
+	: type(DataType::None)
+	, length(0)
+	, intVal(0)
+{}
+
+Data::Data(int val)
+	: Data()
+{
+	setValue(val);
+}
+
+Data::Data(double val)
+	: Data()
+{
+	setValue(val);
+}
+
+Data::Data(const std::string& val)
+	: Data()
+{
+	setValue(val);
+}
+
+Data::Data(std::ifstream& in)
+	: Data()
+{
+	uint8_t tag;
+	in.read((char*)&tag, sizeof(tag));
+
+	switch ((DataType)tag)
+	{
+	case DataType::Int:
+		setValue(unzigzag(readVarint(in)));
+		break;
+	case DataType::Double:
+	{
+		double val;
+		in.read((char*)&val, sizeof(val));
+		setValue(val);
+		break;
+	}
+	case DataType::String:
+	{
+		std::string val(readVarint(in), '\0');
+		if (!val.empty())
+			in.read(&val[0], val.size());
+		setString(val.data(), val.size());
+		break;
+	}
+	case DataType::DateTime:
+		type = DataType::DateTime;
+		dateVal = readVarint(in);
+		break;
+	default:
+		throw std::exception("Invalid data type in file!");
+	}
+}
+
+Data::Data(const char* buffer, size_t& offset, DataType type)
+	: Data()
+{
+	if (type == DataType::None)
+		type = (DataType)(uint8_t)buffer[offset++];
+
+	decodeValue(buffer, offset, type);
+}
+
+Data Data::fromLegacy(std::ifstream& in)
+{
+	std::string type;
+	size_t len = type.length();
+	in.read((char*)&len, sizeof(len));
+	type.resize(len);
+	in.read((char*)&type[0], len);
+
+	Data res;
+	if (type == "Int")
+	{
+		int val;
+		in.read((char*)&val, sizeof(val));
+		res.setValue(val);
+	}
+	else if (type == "Double")
+	{
+		double val;
+		in.read((char*)&val, sizeof(val));
+		res.setValue(val);
+	}
+	else
+	{
+		// String and DateTime are both saved as a string
+		in.read((char*)&len, sizeof(len));
+		std::string val(len, '\0');
+		if (len > 0)
+			in.read(&val[0], len);
+
+		if (type == "String")
+			res.setString(val.data(), val.size());
+		else
+		{
+			res.type = DataType::DateTime;
+			res.dateVal = DateTime(val).pack();
+		}
+	}
+
+	return res;
+}
+
+Data Data::fromLegacy(const char* buffer, size_t& offset)
+{
+	std::string type;
+	size_t len;
+	std::memcpy(&len, buffer + offset, sizeof(len));
+	offset += sizeof(len);
+	type.assign(buffer + offset, len);
+	offset += len;
+
+	Data res;
+	if (type == "Int")
+	{
+		int val;
+		std::memcpy(&val, buffer + offset, sizeof(val));
+		offset += sizeof(val);
+		res.setValue(val);
+	}
+	else if (type == "Double")
+	{
+		double val;
+		std::memcpy(&val, buffer + offset, sizeof(val));
+		offset += sizeof(val);
+		res.setValue(val);
+	}
+	else
+	{
+		// String and DateTime are both saved as a string
+		std::memcpy(&len, buffer + offset, sizeof(len));
+		offset += sizeof(len);
+
+		if (type == "String")
+			res.setString(buffer + offset, len);
+		else
+		{
+			res.type = DataType::DateTime;
+			res.dateVal = DateTime(std::string(buffer + offset, len)).pack();
+		}
+		offset += len;
+	}
+
+	return res;
+}
+
+Data::Data(const Data& other)
+	: Data()
+{
+	copy(other);
+}
+
+Data::Data(Data&& other) noexcept
+	: Data()
+{
+	move(other);
+}
+
+Data& Data::operator=(const Data& other)
+{
+	if (this != &other)
+	{
+		clear();
+		copy(other);
+	}
+	return *this;
+}
+
+Data& Data::operator=(Data&& other) noexcept
+{
+	if (this != &other)
+	{
+		clear();
+		move(other);
+	}
+	return *this;
+}
+
+Data::~Data()
+{
+	clear();
+}
+
+void Data::serialize(std::ofstream& out) const
+{
+	std::vector<char> buffer(encodedSize());
+	size_t offset = 0;
+	encode(&buffer[0], offset);
+
+	out.write(&buffer[0], buffer.size());
+}
+
+size_t Data::encodedSize(bool tagged) const
+{
+	size_t size = tagged ? sizeof(uint8_t) : 0;
+
+	switch (type)
+	{
+	case DataType::Int:
+		size += varintSize(zigzag(intVal));
+		break;
+	case DataType::Double:
+		size += sizeof(double);
+		break;
+	case DataType::String:
+		size += varintSize(length) + length;
+		break;
+	case DataType::DateTime:
+		size += varintSize(dateVal);
+		break;
+	default:
+		throw std::exception("Data has no value!");
+	}
+
+	return size;
+}
+
+void Data::encode(char* buffer, size_t& offset, bool tagged) const
+{
+	if (type == DataType::None)
+		throw std::exception("Data has no value!");
+
+	if (tagged)
+		buffer[offset++] = (char)type;
+
+	switch (type)
+	{
+	case DataType::Int:
+		writeVarint(buffer, offset, zigzag(intVal));
+		break;
+	case DataType::Double:
+		std::memcpy(buffer + offset, &doubleVal, sizeof(doubleVal));
+		offset += sizeof(doubleVal);
+		break;
+	case DataType::String:
+		writeVarint(buffer, offset, length);
+		std::memcpy(buffer + offset, chars(), length);
+		offset += length;
+		break;
+	case DataType::DateTime:
+		writeVarint(buffer, offset, dateVal);
+		break;
+	default:
+		break;
+	}
+}
+
+int Data::compareValues(const Data& other) const
+{
+	if (type == DataType::None || other.type == DataType::None)
+		return (int)(type != DataType::None) - (int)(other.type != DataType::None);
+
+	switch (type)
+	{
+	case DataType::Int:
+	{
+		int right = other.type == DataType::Int ? other.intVal : other.toInteger();
+		return intVal < right ? -1 : (intVal > right ? 1 : 0);
+	}
+	case DataType::Double:
+		return Double::compare(doubleVal, other.type == DataType::Double ? other.doubleVal : other.toDouble());
+	case DataType::String:
+	{
+		if (other.type == DataType::String)
+			return String::compare(chars(), length, other.chars(), other.length);
+
+		std::string right = other.toString();
+		return String::compare(chars(), length, right.data(), right.size());
+	}
+	case DataType::DateTime:
+	{
+		uint32_t right = other.dateVal;
+		if (other.type != DataType::DateTime)
+		{
+			std::string str = other.toString();
+			if (!isDateTime(str))
+				throw std::invalid_argument("Invalid date given!");
+			right = DateTime(str).pack();
+		}
+		return dateVal < right ? -1 : (dateVal > right ? 1 : 0);
+	}
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+bool Data::equals(const Data& other) const
+{
+	if (type != other.type)
+		return false;
+
+	switch (type)
+	{
+	case DataType::Int:
+		return intVal == other.intVal;
+	case DataType::Double:
+		return Double::printed(doubleVal) == Double::printed(other.doubleVal);
+	case DataType::String:
+		return length == other.length && std::memcmp(chars(), other.chars(), length) == 0;
+	case DataType::DateTime:
+		return dateVal == other.dateVal;
+	default:
+		return true;
+	}
+}
+
+Data Data::convertTo(DataType type) const
+{
+	if (this->type == type || this->type == DataType::None)
+		return *this;
+
+	Data res;
+	switch (type)
+	{
+	case DataType::Int:
+		res.setValue(toInteger());
+		break;
+	case DataType::Double:
+		res.setValue(toDouble());
+		break;
+	case DataType::String:
+	{
+		std::string str = toString();
+		res.setString(str.data(), str.size());
+		break;
+	}
+	case DataType::DateTime:
+	{
+		std::string str = toString();
+		if (!isDateTime(str))
+			throw std::invalid_argument("Invalid date given!");
+		res.type = DataType::DateTime;
+		res.dateVal = DateTime(str).pack();
+		break;
+	}
+	default:
+		break;
+	}
+
+	return res;
+}
+
+uint64_t Data::hash() const
+{
+	return hashValue(false);
+}
+
+uint64_t Data::foldedHash() const
+{
+	return hashValue(true);
+}
+
+uint64_t Data::hashValue(bool foldCase) const
+{
+	uint64_t val = (uint64_t)type;
+
+	switch (type)
+	{
+	case DataType::Int:
+		val = (uint64_t)(uint32_t)intVal;
+		break;
+	case DataType::Double:
+	{
+		double printed = Double::printed(doubleVal);
+		std::memcpy(&val, &printed, sizeof(val));
+		break;
+	}
+	case DataType::String:
+	{
+		// FNV-1a over the characters
+		val = 14695981039346656037ull;
+		const char* str = chars();
+		for (size_t i = 0; i < length; i++)
+			val = (val ^ (uint8_t)(foldCase ? String::toLower(str[i]) : str[i])) * 1099511628211ull;
+		break;
+	}
+	case DataType::DateTime:
+		val = dateVal;
+		break;
+	default:
+		break;
+	}
+
+	// splitmix64 finalizer, so close values have unrelated hashes
+	val += (uint64_t)type * 0x9E3779B97F4A7C15ull;
+	val = (val ^ (val >> 30)) * 0xBF58476D1CE4E5B9ull;
+	val = (val ^ (val >> 27)) * 0x94D049BB133111EBull;
+	return val ^ (val >> 31);
+}
+
+void Data::appendSortKey(std::string& key, bool descending) const
+{
+	size_t start = key.size();
+
+	// a value without type comes before all values
+	key.push_back(type == DataType::None ? 0 : 1);
+
+	// the numbers are written big-endian, so the first different byte decides
+	auto appendNumber = [&key](uint64_t val, size_t bytes)
+	{
+		for (size_t i = bytes; i > 0; i--)
+			key.push_back((char)(uint8_t)(val >> (8 * (i - 1))));
+	};
+
+	// a zero byte of a string is written as two bytes, so the two zero bytes after the string come before any character
+	auto appendChars = [&key](const char* str, size_t len, bool lower)
+	{
+		for (size_t i = 0; i < len; i++)
+		{
+			key.push_back(lower ? String::toLower(str[i]) : str[i]);
+			if (str[i] == 0)
+				key.push_back((char)0xFF);
+		}
+		key.append(2, 0);
+	};
+
+	switch (type)
+	{
+	case DataType::Int:
+		// flipping the sign bit orders the negative numbers before the positive ones
+		appendNumber((uint32_t)intVal ^ 0x80000000u, 4);
+		break;
+	case DataType::Double:
+	{
+		// the bits of a positive double are ordered like the number, the bits of a negative one are inverted
+		uint64_t bits;
+		std::memcpy(&bits, &doubleVal, sizeof(bits));
+		appendNumber(bits & 0x8000000000000000ull ? ~bits : bits | 0x8000000000000000ull, 8);
+		break;
+	}
+	case DataType::String:
+		appendChars(chars(), length, true);
+		appendChars(chars(), length, false);
+		break;
+	case DataType::DateTime:
+		appendNumber(dateVal, 4);
+		break;
+	default:
+		break;
+	}
+
+	if (descending)
+	{
+		for (size_t i = start; i < key.size(); i++)
+			key[i] = ~key[i];
+	}
+}
+
+std::string Data::toString() const
+{
+	switch (type)
+	{
+	case DataType::Int:
+		return std::to_string(intVal);
+	case DataType::Double:
+		return Double::format(doubleVal);
+	case DataType::String:
+		return std::string(chars(), length);
+	case DataType::DateTime:
+		return DateTime::unpack(dateVal).toString();
+	default:
+		throw std::exception("Data has no value!");
+	}
+}
+
+int Data::toInteger() const
+{
+	switch (type)
+	{
+	case DataType::Int:
+		return intVal;
+	case DataType::Double:
+		return (int)doubleVal;
+	case DataType::String:
+		return length == 0 ? 0 : std::stoi(toString());
+	case DataType::DateTime:
+		return DateTime::unpack(dateVal).getDay();
+	default:
+		throw std::exception("Data has no value!");
+	}
+}
+
+double Data::toDouble() const
+{
+	switch (type)
+	{
+	case DataType::Int:
+		return intVal;
+	case DataType::Double:
+		return doubleVal;
+	case DataType::String:
+		return length == 0 ? 0 : std::stod(toString());
+	case DataType::DateTime:
+		return DateTime::unpack(dateVal).getDay();
+	default:
+		throw std::exception("Data has no value!");
+	}
+}
+
+void Data::setValue(int val)
+{
+	clear();
+	type = DataType::Int;
+	intVal = val;
+}
+
+void Data::setValue(double val)
+{
+	clear();
+	type = DataType::Double;
+	doubleVal = val;
+}
+
+void Data::setValue(const std::string& val)
+{
+	if (isDateTime(val))
+	{
+		uint32_t packed = DateTime(val).pack();
+		clear();
+		type = DataType::DateTime;
+		dateVal = packed;
+	}
+	else
+		setString(val.data(), val.size());
+}
+
+unsigned int Data::getBytes() const
+{
+	switch (type)
+	{
+	case DataType::Int:
+		return Integer().getBytes();
+	case DataType::Double:
+		return Double().getBytes();
+	case DataType::String:
+		return String().getBytes();
+	case DataType::DateTime:
+		return DateTime().getBytes();
+	default:
+		return 0;
+	}
+}
+
+DataType Data::typeFromName(const std::string& name)
+{
+	if (name == "Int")
+		return DataType::Int;
+	else if (name == "Double")
+		return DataType::Double;
+	else if (name == "String")
+		return DataType::String;
+	else if (name == "DateTime")
+		return DataType::DateTime;
+
+	return DataType::None;
+}
+
+void Data::copy(const Data& other)
+{
+	if (other.type == DataType::String)
+		setString(other.chars(), other.length);
+	else
+	{
+		type = other.type;
+		length = other.length;
+		std::memcpy(small, other.small, SSO_CAPACITY);
+	}
+}
+
+void Data::move(Data& other)
+{
+	type = other.type;
+	length = other.length;
+	std::memcpy(small, other.small, SSO_CAPACITY);
+
+	// the heap string (if there is such) now belongs to this object
+	other.type = DataType::None;
+	other.length = 0;
+}
+
+void Data::clear()
+{
+	if (type == DataType::String && length > SSO_CAPACITY)
+		delete[] heap;
+
+	type = DataType::None;
+	length = 0;
+}
+
+void Data::setString(const char* chars, size_t len)
+{
+	clear();
+	type = DataType::String;
+	length = len;
+
+	if (len <= SSO_CAPACITY)
+		std::memcpy(small, chars, len);
+	else
+	{
+		heap = new char[len];
+		std::memcpy(heap, chars, len);
+	}
+}
+
+size_t Data::varintSize(uint64_t val)
+{
+	size_t size = 1;
+	while (val >= 0x80)
+	{
+		val >>= 7;
+		size++;
+	}
+	return size;
+}
+
+void Data::writeVarint(char* buffer, size_t& offset, uint64_t val)
+{
+	while (val >= 0x80)
+	{
+		buffer[offset++] = (char)((val & 0x7F) | 0x80);
+		val >>= 7;
+	}
+	buffer[offset++] = (char)val;
+}
+
+uint64_t Data::readVarint(const char* buffer, size_t& offset)
+{
+	uint64_t val = 0;
+	for (size_t shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t byte = buffer[offset++];
+		val |= (uint64_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			break;
+	}
+	return val;
+}
+
+uint64_t Data::readVarint(std::ifstream& in)
+{
+	uint64_t val = 0;
+	for (size_t shift = 0; shift < 64; shift += 7)
+	{
+		uint8_t byte = 0;
+		in.read((char*)&byte, sizeof(byte));
+		val |= (uint64_t)(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			break;
+	}
+	return val;
+}
+
+void Data::decodeValue(const char* buffer, size_t& offset, DataType type)
+{
+	switch (type)
+	{
+	case DataType::Int:
+		setValue(unzigzag(readVarint(buffer, offset)));
+		break;
+	case DataType::Double:
+	{
+		double val;
+		std::memcpy(&val, buffer + offset, sizeof(val));
+		offset += sizeof(val);
+		setValue(val);
+		break;
+	}
+	case DataType::String:
+	{
+		size_t len = readVarint(buffer, offset);
+		setString(buffer + offset, len);
+		offset += len;
+		break;
+	}
+	case DataType::DateTime:
+		this->type = DataType::DateTime;
+		dateVal = readVarint(buffer, offset);
+		break;
+	default:
+		throw std::exception("Invalid data type!");
+	}
+}
+
+bool Data::isDateTime(const std::string& str) const
+{
+	std::string day, month, year;
+
+	if (str.size() < 5)
+		return false;
+
+	size_t pipes = 0;
+	for (size_t i = 0; i < str.size(); i++)
+	{
+		if (str[i] == '-')
+			pipes++;
+	}
+	if (pipes != 2)
+		return false;
+
+	size_t ind = 0;
+
+	while (ind < str.size() && str[ind] != '-')
+	{
+		day += str[ind];
+		ind++;
+	}
+	ind++;
+
+	if (day.size() < 1 || day.size() > 2)
+		return false;
+
+	while (ind < str.size() && str[ind] != '-')
+	{
+		month += str[ind];
+		ind++;
+	}
+	ind++;
+
+	if (month.size() < 1 || month.size() > 2)
+		return false;
+
+	while (ind < str.size())
+	{
+		year += str[ind];
+		ind++;
+	}
+
+	if (year.size() < 1 || year.size() > 4)
+		return false;
+
+	return true;
+}
@@ -1,82 +1,256 @@
-#pragma once
-#include <ostream>
-#include "Integer.h"
-#include "String.h"
-#include "Double.h"
-#include "DateTime.h"
-
-/// @brief Wrapper class for the Type class
-
-class Data
-{
-public:
-	Data();
-	/// @brief Constructor with int param
-	/// @param val - the value of the object
-	Data(int val);
-	/// @brief Constructor with double param
-	/// @param val - the value of the object
-	Data(double val);
-	/// @brief Constructor with string param (can be String or DateTime)
-	/// @param val - the value of the object
-	Data(const std::string& val);
-
-	/// @brief Deserializing constructor
-	/// @param in - the file that the object will be read from
-	Data(std::ifstream& in);
-
-	Data(const Data& other);
-	Data& operator=(const Data& other);
-	~Data();
-
-	/// @brief Saves object to file in binary format
-	/// @param out - the file
-	void serialize(std::ofstream& out) const;
-
-	bool operator<(const Data& other) const;
-	bool operator<=(const Data& other) const;
-	bool operator>(const Data& other) const;
-	bool operator>=(const Data& other) const;
-	bool operator==(const Data& other) const;
-	bool operator!=(const Data& other) const;
-
-	/// @brief Gives the value into a string format depending of the type of the object
-	/// @return the converted value
-	std::string toString() const;
-
-	/// @brief Sets the value to a new Integer object
-	/// @param val - the given value of the object
-	void setValue(int val);
-
-	/// @brief Sets the value to a new Double object
-	/// @param val - the given value of the object
-	void setValue(double val);
-
-	/// @brief Sets the value to a new String or DateTime object
-	/// @param val - the given value of the object
-	void setValue(const std::string& val);
-
-	/// @brief Gives the value
-	/// @return the value
-	Type* getValue() const { return value; }
-
-	/// @brief Gives us the size of the object in bytes
-	/// @return the bytes of the value depending of the object type
-	unsigned int getBytes() const { return value->getBytes(); }
-
-private:
-	/// @brief Helper function for the copy constructor
-	/// @param other - the object we copy from
-	void copy(const Data& other);
-
-	/// @brief Helper function for the destructor
-	void clear();
-
-	/// @brief Checks if a gives string is in DateTime format
-	/// @param str - the string to check
-	/// @return true if the string is in DateTime format and false otherwise
-	bool isDateTime(const std::string& str) const;
-
-private:
-	Type* value;
-};
+#pragma once
+#include <ostream>
+#include <fstream>
+#include <cstdint>
+#include "Integer.h"
+#include "String.h"
+#include "Double.h"
+#include "DateTime.h"
+
+/// @brief The type of the value of a Data object. It is also the tag written before the value when it is saved.
+
+enum class DataType : uint8_t
+{
+	None = 0,
+	Int = 1,
+	Double = 2,
+	String = 3,
+	DateTime = 4
+};
+
+/// @brief A value of one of the column types, stored inline: Int, Double and DateTime (packed in one number)
+/// never allocate and strings of up to SSO_CAPACITY characters are kept in the object itself.
+/// Comparisons switch on the type instead of calling virtual functions.
+/// The saved format is a 1-byte type tag followed by the value: Int as a zigzag varint, Double as 8 bytes,
+/// String as a varint length and the characters, DateTime packed in one varint (year, month and day bits).
+/// The tag is left out when the type is known by the reader (the columns of a typed page).
+
+class Data
+{
+public:
+	Data();
+	/// @brief Constructor with int param
+	/// @param val - the value of the object
+	Data(int val);
+	/// @brief Constructor with double param
+	/// @param val - the value of the object
+	Data(double val);
+	/// @brief Constructor with string param (can be String or DateTime)
+	/// @param val - the value of the object
+	Data(const std::string& val);
+
+	/// @brief Deserializing constructor
+	/// @param in - the file that the object will be read from
+	Data(std::ifstream& in);
+
+	/// @brief Constructor that reads the object from a buffer (in the format of serialize)
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the read object
+	/// @param type - the type of the object if it was written without a tag and DataType::None otherwise
+	Data(const char* buffer, size_t& offset, DataType type = DataType::None);
+
+	/// @brief Reads an object saved in the old format (length-prefixed type name before the value)
+	/// @param in - the file that the object will be read from
+	/// @return the read object
+	static Data fromLegacy(std::ifstream& in);
+
+	/// @brief Reads an object saved in a buffer in the old format (length-prefixed type name before the value)
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the read object
+	/// @return the read object
+	static Data fromLegacy(const char* buffer, size_t& offset);
+
+	Data(const Data& other);
+	Data(Data&& other) noexcept;
+	Data& operator=(const Data& other);
+	Data& operator=(Data&& other) noexcept;
+	~Data();
+
+	/// @brief Saves object to file in binary format
+	/// @param out - the file
+	void serialize(std::ofstream& out) const;
+
+	/// @brief Gets the size of the object in the format of serialize
+	/// @param tagged - false if the type tag is left out
+	/// @return the size in bytes
+	size_t encodedSize(bool tagged = true) const;
+
+	/// @brief Writes the object to a buffer in the format of serialize
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the written object
+	/// @param tagged - false if the type tag is left out
+	void encode(char* buffer, size_t& offset, bool tagged = true) const;
+
+	bool operator<(const Data& other) const { return compare(other) < 0; }
+	bool operator<=(const Data& other) const { return compare(other) <= 0; }
+	bool operator>(const Data& other) const { return compare(other) > 0; }
+	bool operator>=(const Data& other) const { return compare(other) >= 0; }
+	bool operator==(const Data& other) const { return compare(other) == 0; }
+	bool operator!=(const Data& other) const { return compare(other) != 0; }
+
+	/// @brief Compares the object with another one. The other value is converted to the type of this one
+	/// if their types differ (as a condition value compared to a column value)
+	/// @param other - the other object
+	/// @return negative if this object is smaller, 0 if they are equal and positive if this object is bigger
+	int compare(const Data& other) const
+	{
+		// the common case of two Int or two DateTime values is compared inline
+		if (type == other.type && type == DataType::Int)
+			return (intVal > other.intVal) - (intVal < other.intVal);
+		if (type == other.type && type == DataType::DateTime)
+			return (dateVal > other.dateVal) - (dateVal < other.dateVal);
+
+		return compareValues(other);
+	}
+
+	/// @brief Checks if the object has the same type and the same value as another one (unlike compare,
+	/// which converts the other value and ignores the case of the letters). Double values are the same
+	/// if they are printed the same, as compare treats close numbers as equal.
+	/// @param other - the other object
+	/// @return true if the type and the value are the same and false otherwise
+	bool equals(const Data& other) const;
+
+	/// @brief Converts the value to a given type the same way compare converts the other value
+	/// @param type - the type
+	/// @return the converted value (the same value if it already has this type or has no value)
+	Data convertTo(DataType type) const;
+
+	/// @brief Gives the value into a string format depending of the type of the object
+	/// @return the converted value
+	std::string toString() const;
+
+	/// @brief Hashes the value. The values that are the same by equals have the same hash
+	/// @return the hash of the value
+	uint64_t hash() const;
+
+	/// @brief Hashes the value the way compare sees it, so a String is hashed by its lowercase characters
+	/// and the strings that differ only in the case of the letters have the same hash (for the Bloom filters)
+	/// @return the hash of the value
+	uint64_t foldedHash() const;
+
+	/// @brief Appends a sort key of the value to a string. The keys of values compare with memcmp the way
+	/// the values compare (a String by its lowercase characters first, then by its characters, so only the same
+	/// strings have the same key). A key is never a prefix of another one, so keys of columns can be appended.
+	/// @param key - the string the key is appended to
+	/// @param descending - true to invert the key, so bigger values have smaller keys
+	void appendSortKey(std::string& key, bool descending = false) const;
+
+	/// @brief Sets the value to a new Integer object
+	/// @param val - the given value of the object
+	void setValue(int val);
+
+	/// @brief Sets the value to a new Double object
+	/// @param val - the given value of the object
+	void setValue(double val);
+
+	/// @brief Sets the value to a new String or DateTime object
+	/// @param val - the given value of the object
+	void setValue(const std::string& val);
+
+	/// @brief Checks if the object has no value
+	/// @return true if the type is DataType::None and false otherwise
+	inline bool isNull() const { return type == DataType::None; }
+
+	/// @brief Gives the value converted to int
+	/// @return the value (the day for a DateTime)
+	int toInteger() const;
+
+	/// @brief Gives the value converted to double
+	/// @return the value (the day for a DateTime)
+	double toDouble() const;
+
+	/// @brief Gives the type of the value
+	/// @return the type or DataType::None if there is no value
+	inline DataType getType() const { return type; }
+
+	/// @brief Converts the name of a column type to a DataType
+	/// @param name - "Int", "Double", "String" or "DateTime"
+	/// @return the type
+	static DataType typeFromName(const std::string& name);
+
+	/// @brief Gives us the size of the object in bytes
+	/// @return the bytes of the value depending of the object type
+	unsigned int getBytes() const;
+
+	/// @brief The longest string that is kept in the object without allocating
+	static constexpr size_t SSO_CAPACITY = 16;
+
+private:
+	/// @brief Hashes the value
+	/// @param foldCase - true if the characters of a String are hashed as lowercase
+	/// @return the hash of the value
+	uint64_t hashValue(bool foldCase) const;
+
+	/// @brief Compares the object with another one (the part of compare that is not inline)
+	/// @param other - the other object
+	/// @return negative if this object is smaller, 0 if they are equal and positive if this object is bigger
+	int compareValues(const Data& other) const;
+
+	/// @brief Helper function for the copy constructor
+	/// @param other - the object we copy from
+	void copy(const Data& other);
+
+	/// @brief Helper function for the move constructor
+	/// @param other - the object we move from, left without a value
+	void move(Data& other);
+
+	/// @brief Helper function for the destructor
+	void clear();
+
+	/// @brief Sets the value to a string, keeping it in the object if it is short enough
+	/// @param chars - the characters of the string
+	/// @param len - the length of the string
+	void setString(const char* chars, size_t len);
+
+	/// @brief Gives the characters of a String value
+	inline const char* chars() const { return length <= SSO_CAPACITY ? small : heap; }
+
+	/// @brief Gives the size of an unsigned number written as a varint (7 bits per byte)
+	/// @param val - the number
+	/// @return the size in bytes
+	static size_t varintSize(uint64_t val);
+
+	/// @brief Writes an unsigned number as a varint
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the written number
+	/// @param val - the number
+	static void writeVarint(char* buffer, size_t& offset, uint64_t val);
+
+	/// @brief Reads an unsigned number written as a varint
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the read number
+	/// @return the number
+	static uint64_t readVarint(const char* buffer, size_t& offset);
+
+	/// @brief Reads an unsigned number written as a varint
+	/// @param in - the file
+	/// @return the number
+	static uint64_t readVarint(std::ifstream& in);
+
+	/// @brief Maps signed numbers to unsigned ones so numbers close to 0 have short varints
+	static uint64_t zigzag(int val) { return ((uint64_t)(int64_t)val << 1) ^ (uint64_t)((int64_t)val >> 63); }
+	static int unzigzag(uint64_t val) { return (int)((val >> 1) ^ (~(val & 1) + 1)); }
+
+	/// @brief Reads the value of a given type from a buffer (without the tag)
+	/// @param buffer - the buffer
+	/// @param offset - the position in the buffer, moved after the read value
+	/// @param type - the type of the value
+	void decodeValue(const char* buffer, size_t& offset, DataType type);
+
+	/// @brief Checks if a gives string is in DateTime format
+	/// @param str - the string to check
+	/// @return true if the string is in DateTime format and false otherwise
+	bool isDateTime(const std::string& str) const;
+
+private:
+	DataType type;
+	uint32_t length; // the length of a String value
+	union
+	{
+		int intVal;
+		double doubleVal;
+		uint32_t dateVal; // packed with DateTime::pack
+		char small[SSO_CAPACITY];
+		char* heap;
+	};
+};
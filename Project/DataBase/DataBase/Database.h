@@ -1,85 +1,130 @@
-#pragma once
-#include <iostream>
-#include "Table.h"
-
-using std::cout;
-using std::exception;
-using std::endl;
-
-/// @brief Class for the database
-
-class Database
-{
-public:
-	Database() {};
-
-	/// @brief Creates a new table and adds to the database
-	/// @param tableHeader - the header of the table
-	/// @param tableName - the name of the table
-	/// @param tableFirstIndex - the first indexed column
-	void createTable(const string& tableHeader, const string& tableName, const string& tableFirstIndex = "");
-
-	/// @brief Removes a table from the database
-	/// @param tableName - the name of the table
-	void dropTable(const string& tableName);
-
-	/// @brief Prints the names of all of the tables in the database
-	void listTables() const;
-
-	/// @brief Inserts rows into a given table
-	/// @param tableName - the name of the table to be inserted in
-	/// @param recordsToInsert - vector of records in string format
-	void insertInto(const string& tableName, const vector<string>& recordsToInsert);
-
-	/// @brief Selects certain rows from the table by given criteria
-	/// @param tableName the name of the table to be selected from
-	/// @param whereExpr - the WHERE expression
-	/// @param orderBy - the column the record will be ordered by
-	/// @param distinct - flag that shows if same records will be printed
-	/// @param toPrint - columns to be printed
-	/// @param selectedCount - ammount of the selected records
-	void selectFrom(const string& tableName, const string& whereExpr, const string& orderBy, bool distinct, const string& toPrint, size_t& selectedCount) const;
-	
-	/// @brief Removes rows from a given table by a criteria
-	/// @param tableName - the name of the table
-	/// @param whereExpr - the WHERE expression
-	void removeFrom(const string& tableName, const string& whereExpr);
-
-	/// @brief Creates an index on a given column in a table
-	/// @param tableName - the name of the table
-	/// @param indexCol - the name of the column to be indexed
-	void createIndex(const string& tableName, const string& indexCol);
-
-	/// @brief Gets the number of tables in the database
-	/// @return the size of the tables
-	inline size_t size() const { return tables.size(); }
-
-	/// @brief Checks if a given table is in the database
-	/// @param tableName - the name of the table
-	/// @return true if the table is in the database and false otherwise
-	inline bool contains(const string& tableName) { return tables.find(tableName) != tables.end(); }
-
-	/// @brief Gets a table with a given name
-	/// @param tableName - the name of the table
-	/// @return the table
-	Table getTable(const string& tableName) const;
-
-	/// @brief Reads the database from a file
-	/// @param in - the file to be read from
-	void deserialize(ifstream& in);
-
-	/// @brief Writes the database to a file in a binary format
-	/// @param out - the file to be written in
-	void serialize(ofstream& out) const;
-
-private:
-	/// @brief Prints the selected rows in the select function
-	/// @param maxSizesHT - hash table containing the maximum sizes of every column in the print format
-	/// @param colNames - names of the columns to be printed
-	/// @param selected - rows to be printed
-	void parseSelected(unordered_map<string, size_t>& maxSizesHT, const vector<string>& colNames, const vector<string>& selected) const;
-
-private:
-	unordered_map<string, Table> tables;
-};
-
+#pragma once
+#include <iostream>
+#include "Table.h"
+
+using std::cout;
+using std::exception;
+using std::endl;
+
+const size_t SELECT_BATCH_SIZE = 1000; // the selected rows are printed in batches of this size
+
+/// @brief Class for the database
+
+class Database
+{
+public:
+	Database() {};
+
+	/// @brief Creates a new table and adds to the database
+	/// @param tableHeader - the header of the table
+	/// @param tableName - the name of the table
+	/// @param tableFirstIndex - the first indexed column
+	/// @param pageSize - the size of the pages of the table in bytes
+	void createTable(const string& tableHeader, const string& tableName, const string& tableFirstIndex = "", size_t pageSize = PAGE_SIZE);
+
+	/// @brief Removes a table from the database
+	/// @param tableName - the name of the table
+	void dropTable(const string& tableName);
+
+	/// @brief Prints the names of all of the tables in the database
+	void listTables() const;
+
+	/// @brief Inserts rows into a given table
+	/// @param tableName - the name of the table to be inserted in
+	/// @param recordsToInsert - vector of records in string format
+	void insertInto(const string& tableName, const vector<string>& recordsToInsert);
+
+	/// @brief Selects certain rows from the table by given criteria
+	/// @param tableName the name of the table to be selected from
+	/// @param whereExpr - the WHERE expression
+	/// @param orderBy - the column the record will be ordered by
+	/// @param distinct - flag that shows if same records will be printed
+	/// @param toPrint - columns to be printed
+	/// @param selectedCount - ammount of the selected records
+	/// @param limit - the maximum ammount of selected records
+	void selectFrom(const string& tableName, const string& whereExpr, const string& orderBy, bool distinct, const string& toPrint, size_t& selectedCount,
+		size_t limit = NO_LIMIT) const;
+	
+	/// @brief Prints aggregates (COUNT, SUM, AVG, MIN and MAX) of the rows of a given table that satisfy a criteria,
+	/// for every group of rows with the same values of the GROUP BY columns
+	/// @param tableName - the name of the table
+	/// @param whereExpr - the WHERE expression
+	/// @param groupBy - the columns the rows are grouped by (empty for one group of all rows)
+	/// @param toPrint - the aggregates and the GROUP BY columns to be printed
+	/// @param orderBy - the printed items the groups are ordered by
+	/// @param selectedCount - ammount of the printed groups
+	/// @param limit - the maximum ammount of printed groups
+	void aggregateFrom(const string& tableName, const string& whereExpr, const string& groupBy, const string& toPrint,
+		const string& orderBy, size_t& selectedCount, size_t limit = NO_LIMIT) const;
+
+	/// @brief Removes rows from a given table by a criteria
+	/// @param tableName - the name of the table
+	/// @param whereExpr - the WHERE expression
+	void removeFrom(const string& tableName, const string& whereExpr);
+
+	/// @brief Creates an index on a given column in a table
+	/// @param tableName - the name of the table
+	/// @param indexCol - the name of the column to be indexed
+	void createIndex(const string& tableName, const string& indexCol);
+
+	/// @brief Creates a Bloom filter of a given column in a table
+	/// @param tableName - the name of the table
+	/// @param col - the name of the column
+	/// @param bitsPerKey - the bits of the filter for every row
+	void createBloomFilter(const string& tableName, const string& col, size_t bitsPerKey);
+
+	/// @brief Writes the rows of a table again into as few pages as possible in the order of an index
+	/// @param tableName - the name of the table
+	/// @param clusterCol - the indexed column that gives the order of the rows (the first indexed column if empty)
+	void vacuum(const string& tableName, const string& clusterCol = "");
+
+	/// @brief Gets the number of tables in the database
+	/// @return the size of the tables
+	inline size_t size() const { return tables.size(); }
+
+	/// @brief Checks if a given table is in the database
+	/// @param tableName - the name of the table
+	/// @return true if the table is in the database and false otherwise
+	inline bool contains(const string& tableName) { return tables.find(tableName) != tables.end(); }
+
+	/// @brief Gets the number of pages of a given table
+	/// @param tableName - the name of the table
+	/// @return the number of pages
+	size_t getPageCount(const string& tableName) const;
+
+	/// @brief Gets a table with a given name
+	/// @param tableName - the name of the table
+	/// @return the table
+	Table getTable(const string& tableName) const;
+
+	/// @brief Reads the database from a file
+	/// @param in - the file to be read from
+	void deserialize(ifstream& in);
+
+	/// @brief Writes the database to a file in a binary format
+	/// @param out - the file to be written in
+	void serialize(ofstream& out) const;
+
+private:
+	/// @brief Prints the rows of a query in batches as they are given, the first batch after the names of the columns
+	/// @param colNames - names of the columns to be printed
+	/// @param query - runs the query, passing every row in string format to the given sink, and returns the number of rows
+	/// @return the number of rows
+	size_t printInBatches(const vector<string>& colNames, const function<size_t(const function<void(const string&)>&)>& query) const;
+
+	/// @brief Prints a batch of the selected rows in the select function
+	/// @param maxSizesHT - hash table containing the maximum sizes of every column in the print format
+	/// @param colNames - names of the columns to be printed
+	/// @param selected - rows to be printed
+	/// @param printHeader - true for the first batch, which is printed after the names of the columns
+	void parseSelected(unordered_map<string, size_t>& maxSizesHT, const vector<string>& colNames, const vector<string>& selected, bool printHeader) const;
+
+	/// @brief Prints the names of the columns in the select function
+	/// @param maxSizesHT - hash table containing the maximum sizes of every column in the print format
+	/// @param colNames - names of the columns to be printed
+	void printSelectedHeader(unordered_map<string, size_t>& maxSizesHT, const vector<string>& colNames) const;
+
+private:
+	unordered_map<string, Table> tables;
+};
+
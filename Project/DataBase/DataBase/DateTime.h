@@ -1,55 +1,51 @@
-#pragma once
-#include "Type.h"
-
-/// @brief class deriving Type with value in date format
-
-class DateTime : public Type
-{
-public:
-	DateTime(const std::string& value = "");
-	DateTime& operator=(const DateTime& other);
-
-	/// @brief Creates a new DateTime object
-	/// @return new DateTime
-	virtual Type* clone() const override;
-
-	/// @brief Saves object to file in binary format
-	/// @param out - the file
-	virtual void serialize(std::ofstream& out) const override;
-
-	/// @brief Reads the object from a file in binary format
-	/// @param in - the file
-	virtual void deserialize(std::ifstream& in) override;
-
-	virtual bool operator<(const Type& other) const override;
-	virtual bool operator<=(const Type& other) const override;
-	virtual bool operator>(const Type& other) const override;
-	virtual bool operator>=(const Type& other) const override;
-	virtual bool operator==(const Type& other) const override;
-	virtual bool operator!=(const Type& other) const override;
-
-	/// @brief Turns the date into a string in day-month-year format
-	/// @return the string
-	virtual std::string toString() const override;
-
-	/// @brief Gives us the size of the object in bytes
-	/// @return the sum of sizes of day, month and year
-	virtual unsigned int getBytes() const override { return sizeof(day) + sizeof(month) + sizeof(year); }
-private:
-	/// @brief Gives the day
-	/// @return the day
-	virtual int toInteger() const override { return day; };
-
-	/// @brief Gives the day
-	/// @return the day
-	virtual double toDouble() const override { return day; };
-
-	/// @brief Reads a string and sets values to day, month and year 
-	/// @param value - the string to be read
-	void setValue(const std::string& value);
-
-	int day;
-	int month;
-	int year;
-};
-
+#pragma once
+#include <string>
+#include <cstdint>
+
+/// @brief Value class with value in date format
+
+class DateTime
+{
+public:
+	DateTime(const std::string& value = "");
+	DateTime(int day, int month, int year);
+	DateTime& operator=(const DateTime& other);
+
+	bool operator<(const DateTime& other) const { return pack() < other.pack(); }
+	bool operator<=(const DateTime& other) const { return pack() <= other.pack(); }
+	bool operator>(const DateTime& other) const { return pack() > other.pack(); }
+	bool operator>=(const DateTime& other) const { return pack() >= other.pack(); }
+	bool operator==(const DateTime& other) const { return pack() == other.pack(); }
+	bool operator!=(const DateTime& other) const { return pack() != other.pack(); }
+
+	/// @brief Turns the date into a string in day-month-year format
+	/// @return the string
+	std::string toString() const;
+
+	/// @brief Gives us the size of the object in bytes
+	/// @return the sum of sizes of day, month and year
+	unsigned int getBytes() const { return sizeof(day) + sizeof(month) + sizeof(year); }
+
+	/// @brief Packs the date in one number (5 bits for the day, 4 for the month and the rest for the year),
+	/// so comparing the packed numbers compares the dates
+	/// @return the packed date
+	uint32_t pack() const;
+
+	/// @brief Unpacks a date packed with pack()
+	/// @param packed - the packed date
+	/// @return the date
+	static DateTime unpack(uint32_t packed);
+
+	inline int getDay() const { return day; }
+	inline int getMonth() const { return month; }
+	inline int getYear() const { return year; }
+private:
+	/// @brief Reads a string and sets values to day, month and year 
+	/// @param value - the string to be read
+	void setValue(const std::string& value);
+
+	int day;
+	int month;
+	int year;
+};
+
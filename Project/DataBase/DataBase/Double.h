@@ -1,49 +1,55 @@
-#pragma once
-#include "Type.h"
-
-/// @brief class deriving Type with double value
-
-class Double : public Type
-{
-public:
-	Double(double value = 0);
-
-	/// @brief Creates a new Double object
-	/// @return new Double
-	virtual Type* clone() const override;
-
-	/// @brief Saves object to file in binary format
-	/// @param out - the file
-	virtual void serialize(std::ofstream& out) const override;
-
-	/// @brief Reads the object from a file in binary format
-	/// @param in - the file
-	virtual void deserialize(std::ifstream& in) override;
-
-	virtual bool operator<(const Type& other) const override;
-	virtual bool operator<=(const Type& other) const override;
-	virtual bool operator>(const Type& other) const override;
-	virtual bool operator>=(const Type& other) const override;
-	virtual bool operator==(const Type& other) const override;
-	virtual bool operator!=(const Type& other) const override;
-
-	/// @brief Gives us the value of the object
-	/// @return the value
-	virtual double toDouble() const override;
-
-	/// @brief Gives us the size of the object in bytes
-	/// @return the size of the value
-	virtual unsigned int getBytes() const override { return sizeof(value); }
-
-	/// @brief Turns the value into a string and rounds it to the 3rd digit
-	/// @return the string
-	virtual std::string toString() const override;
-
-private:
-	/// @brief Gives us the value of the object converted to int
-	/// @return the value
-	virtual int toInteger() const override;
-
-	double value;
-	const double EPS = 0.0001;
+#pragma once
+#include <string>
+
+/// @brief Value class with double value
+
+class Double
+{
+public:
+	Double(double value = 0);
+
+	bool operator<(const Double& other) const { return compare(value, other.value) < 0; }
+	bool operator<=(const Double& other) const { return compare(value, other.value) <= 0; }
+	bool operator>(const Double& other) const { return compare(value, other.value) > 0; }
+	bool operator>=(const Double& other) const { return compare(value, other.value) >= 0; }
+	bool operator==(const Double& other) const { return compare(value, other.value) == 0; }
+	bool operator!=(const Double& other) const { return compare(value, other.value) != 0; }
+
+	/// @brief Gives us the value of the object
+	/// @return the value
+	double toDouble() const { return value; }
+
+	/// @brief Gives us the size of the object in bytes
+	/// @return the size of the value
+	unsigned int getBytes() const { return sizeof(value); }
+
+	/// @brief Turns the value into a string with 3 digits after the decimal point
+	/// @return the string
+	std::string toString() const { return format(value); }
+
+	/// @brief Compares two numbers, treating numbers closer than EPS as equal
+	/// @param left - the first number
+	/// @param right - the second number
+	/// @return negative if left is smaller, 0 if they are equal and positive if left is bigger
+	static int compare(double left, double right);
+
+	/// @brief Turns a number into a string with 3 digits after the decimal point
+	/// @param value - the number
+	/// @return the string
+	static std::string format(double value);
+
+	/// @brief Cuts a number to the digits that format shows (-0.000 becomes 0), so the numbers that are
+	/// printed the same are the same
+	/// @param value - the number
+	/// @return the cut number
+	static double printed(double value);
+
+	static constexpr double EPS = 0.0001;
+
+private:
+	/// @brief Gives us the value of the object converted to int
+	/// @return the value
+	int toInteger() const { return value; }
+
+	double value;
 };
\ No newline at end of file
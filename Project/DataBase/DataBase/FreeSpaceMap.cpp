@@ -0,0 +1,81 @@
+#include "FreeSpaceMap.h"
+#include <algorithm>
+#include <stdexcept>
+
+FreeSpaceMap::FreeSpaceMap()
+	: pages(0)
+	, leaves(1)
+	, tree(2, 0)
+{}
+
+FreeSpaceMap::FreeSpaceMap(std::ifstream& in)
+	: FreeSpaceMap()
+{
+	size_t len;
+	in.read((char*)&len, sizeof(len));
+
+	vector<uint32_t> spaces(len);
+	if (len > 0)
+		in.read((char*)&spaces[0], len * sizeof(uint32_t));
+
+	for (size_t i = 0; i < len; i++)
+		update(i + 1, spaces[i]);
+}
+
+void FreeSpaceMap::update(size_t pageNum, size_t space)
+{
+	if (pageNum == 0)
+		throw std::invalid_argument("Invalid page number!");
+
+	if (pageNum > leaves)
+		grow(pageNum);
+	pages = std::max(pages, pageNum);
+
+	size_t node = leaves + pageNum - 1;
+	tree[node] = (uint32_t)space;
+	for (node /= 2; node > 0; node /= 2)
+		tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+}
+
+size_t FreeSpaceMap::findPage(size_t space) const
+{
+	if (pages == 0 || tree[1] < space)
+		return 0;
+
+	// go to the left child whenever it has enough space, so the page with the smallest number is found
+	size_t node = 1;
+	while (node < leaves)
+		node = tree[2 * node] >= space ? 2 * node : 2 * node + 1;
+
+	return node - leaves + 1;
+}
+
+size_t FreeSpaceMap::getSpace(size_t pageNum) const
+{
+	if (pageNum == 0 || pageNum > pages)
+		throw std::invalid_argument("Invalid page number!");
+
+	return tree[leaves + pageNum - 1];
+}
+
+void FreeSpaceMap::serialize(std::ofstream& out) const
+{
+	out.write((const char*)&pages, sizeof(pages));
+	if (pages > 0)
+		out.write((const char*)&tree[leaves], pages * sizeof(uint32_t));
+}
+
+void FreeSpaceMap::grow(size_t pageNum)
+{
+	size_t newLeaves = leaves;
+	while (newLeaves < pageNum)
+		newLeaves *= 2;
+
+	vector<uint32_t> newTree(2 * newLeaves, 0);
+	std::copy(tree.begin() + leaves, tree.begin() + leaves + pages, newTree.begin() + newLeaves);
+	for (size_t node = newLeaves - 1; node > 0; node--)
+		newTree[node] = std::max(newTree[2 * node], newTree[2 * node + 1]);
+
+	leaves = newLeaves;
+	tree = std::move(newTree);
+}
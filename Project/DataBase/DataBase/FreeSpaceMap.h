@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+using std::vector;
+
+/// @brief A map of the free space of the pages of a table, so an insert can find a page with space for a row
+/// (in the last page or in the space left by removed rows) without reading the pages.
+/// The space of every page is a leaf of a max tree, so the first page with enough space is found in O(log n).
+
+class FreeSpaceMap
+{
+public:
+	FreeSpaceMap();
+
+	/// @brief Deserializing constructor
+	/// @param in - the file that the object will be read from
+	FreeSpaceMap(std::ifstream& in);
+
+	/// @brief Sets the free space of a page, adding the page if it is new
+	/// @param pageNum - the number of the page
+	/// @param space - the biggest row (in encoded form) that fits in the page
+	void update(size_t pageNum, size_t space);
+
+	/// @brief Finds the first page with enough space for a row
+	/// @param space - the size of the row
+	/// @return the number of the page or 0 if no page has enough space
+	size_t findPage(size_t space) const;
+
+	/// @brief Gets the free space of a page
+	/// @param pageNum - the number of the page
+	/// @return the biggest row that fits in the page
+	size_t getSpace(size_t pageNum) const;
+
+	inline size_t getPageCount() const { return pages; }
+
+	/// @brief Saves the map to a file in binary format
+	/// @param out - the file
+	void serialize(std::ofstream& out) const;
+
+private:
+	/// @brief Doubles the number of leaves of the tree until a page fits, keeping the spaces of the pages
+	/// @param pageNum - the number of the page
+	void grow(size_t pageNum);
+
+private:
+	size_t pages;
+	size_t leaves; // a power of two, the leaf of page N is tree[leaves + N - 1]
+	vector<uint32_t> tree; // tree[1] is the root, every node has the biggest space of its children
+};
+
@@ -0,0 +1,879 @@
+#include "Operator.h"
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+string Operator::toRow(const Record& record)
+{
+	string row;
+	for (size_t i = 0; i < record.size(); i++)
+	{
+		// an aggregate of no values has no value
+		const Data& value = record.getColData(i);
+		row += (value.isNull() ? "NULL" : value.toString()) + ' ';
+	}
+
+	if (!row.empty())
+		row.pop_back();
+
+	return row;
+}
+
+TableScan::TableScan(const string& table, size_t lastPage, function<bool(size_t)> skipPage)
+	: table(table)
+	, lastPage(lastPage)
+	, skipPage(std::move(skipPage))
+	, pageNum(0)
+	, ind(0)
+{}
+
+bool TableScan::next(Record& record)
+{
+	while (ind == batch.size())
+	{
+		if (pageNum == lastPage)
+			return false;
+
+		// the live rows of the next page are read at once, so the page is taken from the buffer pool only once
+		pageNum++;
+		batch.clear();
+		ind = 0;
+
+		if (skipPage && skipPage(pageNum))
+			continue;
+
+		const Page& page = BufferPool::i().getPage(table, pageNum);
+		for (size_t i = 0; i < page.size(); i++)
+		{
+			Record row = page.getRecord(i);
+			if (!row.isEmpty())
+				batch.push_back(std::move(row));
+		}
+	}
+
+	record = std::move(batch[ind++]);
+	return true;
+}
+
+IndexFetch::IndexFetch(const string& table, vector<RecordPtr> recordPtrs)
+	: table(table)
+	, recordPtrs(std::move(recordPtrs))
+	, pos(0)
+	, ind(0)
+{
+	if (!std::is_sorted(this->recordPtrs.begin(), this->recordPtrs.end()))
+		std::sort(this->recordPtrs.begin(), this->recordPtrs.end());
+}
+
+bool IndexFetch::next(Record& record)
+{
+	if (ind == batch.size())
+	{
+		if (pos == recordPtrs.size())
+			return false;
+
+		batch.clear();
+		ind = 0;
+
+		size_t pageNum = recordPtrs[pos].pageNumber();
+		const Page& page = BufferPool::i().getPage(table, pageNum);
+		for (; pos < recordPtrs.size() && recordPtrs[pos].pageNumber() == pageNum; pos++)
+			batch.push_back(page.getRecord(recordPtrs[pos].rowNumber()));
+	}
+
+	record = std::move(batch[ind++]);
+	return true;
+}
+
+IndexScan::IndexScan(const string& table, const BPlusTree& index, const RowBitmap& rows, const IndexBounds& bounds)
+	: table(table)
+	, rows(rows)
+	, cursor(index.range(bounds.from, bounds.to))
+{}
+
+bool IndexScan::next(Record& record)
+{
+	for (; cursor.isValid(); ++cursor)
+	{
+		RecordPtr recPtr = cursor->second;
+		if (rows.contains(recPtr))
+		{
+			++cursor;
+			record = BufferPool::i().getPage(table, recPtr.pageNumber()).getRecord(recPtr.rowNumber());
+			return true;
+		}
+	}
+
+	return false;
+}
+
+IndexOnlyScan::IndexOnlyScan(const RowBitmap& rows, vector<const BPlusTree*> indexes, vector<IndexBounds> bounds,
+	size_t orderCol)
+	: rows(rows)
+	, indexes(std::move(indexes))
+	, bounds(std::move(bounds))
+	, cursor(walk(0))
+	, collected(false)
+	, orderCol(orderCol)
+	, ind(0)
+{}
+
+bool IndexOnlyScan::next(Record& record)
+{
+	// the values of a single column are given as they are walked
+	if (indexes.size() == 1)
+	{
+		for (; cursor.isValid(); ++cursor)
+		{
+			if (rows.contains(cursor->second))
+			{
+				record = Record();
+				record.addColumn(cursor->first);
+				++cursor;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	if (!collected)
+	{
+		collect();
+		collected = true;
+	}
+
+	if (ind == recordPtrs.size())
+		return false;
+
+	size_t pos = order.empty() ? ind : order[ind];
+	record = Record();
+	for (size_t j = 0; j < columns.size(); j++)
+		record.addColumn(std::move(columns[j][pos]));
+	ind++;
+
+	return true;
+}
+
+BPlusTree::Cursor IndexOnlyScan::walk(size_t j) const
+{
+	if (bounds.empty())
+		return indexes[j]->range();
+
+	return indexes[j]->range(bounds[j].from, bounds[j].to);
+}
+
+void IndexOnlyScan::collect()
+{
+	recordPtrs = rows.toRecordPtrs();
+	columns.assign(indexes.size(), vector<Data>(recordPtrs.size()));
+
+	// the leaves are sorted by value, so every value is put at the place of its row
+	for (size_t j = 0; j < indexes.size(); j++)
+	{
+		for (BPlusTree::Cursor it = walk(j); it.isValid(); ++it)
+		{
+			if (!rows.contains(it->second))
+				continue;
+
+			size_t pos = std::lower_bound(recordPtrs.begin(), recordPtrs.end(), it->second) - recordPtrs.begin();
+			columns[j][pos] = it->first;
+			if (j == orderCol)
+				order.push_back(pos);
+		}
+	}
+}
+
+Filter::Filter(unique_ptr<Operator> child, function<bool(const Record&)> condition)
+	: child(std::move(child))
+	, condition(std::move(condition))
+{}
+
+bool Filter::next(Record& record)
+{
+	while (child->next(record))
+	{
+		if (condition(record))
+			return true;
+	}
+
+	return false;
+}
+
+size_t Sort::memoryBudget = DEFAULT_SORT_MEMORY;
+size_t Sort::nextRunId = 0;
+
+Sort::Sort(unique_ptr<Operator> child, vector<SortKey> keys)
+	: child(std::move(child))
+	, keys(std::move(keys))
+	, sorted(false)
+	, rowsBytes(0)
+	, ind(0)
+	, runCount(0)
+{}
+
+Sort::~Sort()
+{
+	for (size_t i = 0; i < runs.size(); i++)
+		removeRun(*runs[i]);
+}
+
+bool Sort::next(Record& record)
+{
+	if (!sorted)
+	{
+		collect();
+		sorted = true;
+	}
+
+	SortEntry entry;
+	if (!nextSorted(entry))
+		return false;
+
+	record = std::move(entry.row);
+	return true;
+}
+
+void Sort::setMemoryBudget(size_t bytes)
+{
+	if (bytes == 0)
+		throw std::invalid_argument("Sort memory must be positive!");
+
+	memoryBudget = bytes;
+}
+
+void Sort::makeKey(SortEntry& entry, const vector<SortKey>& keys)
+{
+	entry.key.clear();
+	for (size_t i = 0; i < keys.size(); i++)
+		entry.row.getColData(keys[i].colInd).appendSortKey(entry.key, keys[i].descending);
+}
+
+void Sort::sortEntries(vector<SortEntry>& entries, const vector<SortKey>& keys)
+{
+	auto less = [](const SortEntry& left, const SortEntry& right) { return left.key < right.key; };
+
+	size_t parts = std::min(ThreadPool::i().getThreadCount(), entries.size() / MIN_ROWS_PER_SORT_TASK);
+	if (parts <= 1)
+	{
+		for (size_t i = 0; i < entries.size(); i++)
+			makeKey(entries[i], keys);
+		std::sort(entries.begin(), entries.end(), less);
+		return;
+	}
+
+	// every thread builds the keys of a part of the rows and sorts the part
+	vector<size_t> bounds(parts + 1);
+	for (size_t i = 0; i <= parts; i++)
+		bounds[i] = entries.size() * i / parts;
+
+	vector<function<void()>> tasks;
+	for (size_t i = 0; i < parts; i++)
+	{
+		tasks.push_back([&entries, &keys, less, begin = bounds[i], end = bounds[i + 1]]()
+		{
+			for (size_t j = begin; j < end; j++)
+				makeKey(entries[j], keys);
+			std::sort(entries.begin() + begin, entries.begin() + end, less);
+		});
+	}
+	ThreadPool::i().run(tasks);
+
+	// the sorted parts are merged in pairs until one is left, every pair is split into pieces merged by different threads
+	vector<SortEntry> merged(entries.size());
+	while (bounds.size() > 2)
+	{
+		size_t pairs = (bounds.size() - 1) / 2 + (bounds.size() - 1) % 2;
+		size_t pieces = std::max<size_t>(1, ThreadPool::i().getThreadCount() / pairs);
+		vector<size_t> nextBounds;
+		tasks.clear();
+
+		for (size_t i = 0; i + 1 < bounds.size(); i += 2)
+		{
+			size_t begin = bounds[i];
+			size_t middle = bounds[i + 1];
+			size_t end = i + 2 < bounds.size() ? bounds[i + 2] : middle;
+			nextBounds.push_back(begin);
+
+			// a piece takes a part of the left half and the rows of the right half that are before the next part
+			vector<size_t> leftSplits, rightSplits;
+			for (size_t k = 0; k <= pieces; k++)
+			{
+				size_t left = begin + (middle - begin) * k / pieces;
+				size_t right = k == 0 ? middle : k == pieces ? end
+					: std::lower_bound(entries.begin() + middle, entries.begin() + end, entries[left], less) - entries.begin();
+				leftSplits.push_back(left);
+				rightSplits.push_back(right);
+			}
+
+			for (size_t k = 0; k < pieces; k++)
+			{
+				size_t out = begin + (leftSplits[k] - begin) + (rightSplits[k] - middle);
+				tasks.push_back([&entries, &merged, less, out, leftBegin = leftSplits[k], leftEnd = leftSplits[k + 1],
+					rightBegin = rightSplits[k], rightEnd = rightSplits[k + 1]]()
+				{
+					std::merge(std::make_move_iterator(entries.begin() + leftBegin), std::make_move_iterator(entries.begin() + leftEnd),
+						std::make_move_iterator(entries.begin() + rightBegin), std::make_move_iterator(entries.begin() + rightEnd),
+						merged.begin() + out, less);
+				});
+			}
+		}
+		nextBounds.push_back(entries.size());
+
+		ThreadPool::i().run(tasks);
+		entries.swap(merged);
+		bounds.swap(nextBounds);
+	}
+}
+
+void Sort::collect()
+{
+	SortEntry entry;
+	while (child->next(entry.row))
+	{
+		// the key takes about as much memory as the encoded row
+		rowsBytes += sizeof(SortEntry) + entry.row.size() * sizeof(Data) + 2 * entry.row.encodedSize(false);
+		rows.push_back(std::move(entry));
+
+		if (rowsBytes > memoryBudget)
+			spill();
+	}
+
+	if (runs.empty())
+	{
+		sortEntries(rows, keys);
+		return;
+	}
+
+	// the rows left in memory are a run too, so all rows are merged the same way
+	if (!rows.empty())
+		spill();
+
+	mergeRuns();
+	for (size_t i = 0; i < runs.size(); i++)
+	{
+		runs[i]->file.seekg(0);
+		if (readRow(*runs[i]))
+			heap.push_back(i);
+	}
+
+	auto greater = [this](size_t left, size_t right) { return runs[right]->current.key < runs[left]->current.key; };
+	std::make_heap(heap.begin(), heap.end(), greater);
+}
+
+void Sort::spill()
+{
+	sortEntries(rows, keys);
+
+	unique_ptr<Run> run = createRun();
+	for (size_t i = 0; i < rows.size(); i++)
+		writeRow(*run, rows[i].row);
+
+	run->file.flush();
+	if (!run->file)
+		throw std::exception("Couldn't write sort run!");
+
+	runs.push_back(std::move(run));
+	rows.clear();
+	rowsBytes = 0;
+}
+
+void Sort::mergeRuns()
+{
+	// every merged run has a buffer and an open file, so too many runs are merged in steps
+	while (runs.size() > MAX_MERGED_RUNS)
+	{
+		vector<unique_ptr<Run>> merged;
+		for (size_t i = 0; i < MAX_MERGED_RUNS; i++)
+			merged.push_back(std::move(runs[i]));
+		runs.erase(runs.begin(), runs.begin() + MAX_MERGED_RUNS);
+
+		vector<size_t> mergeHeap;
+		runs.swap(merged);
+		for (size_t i = 0; i < runs.size(); i++)
+		{
+			runs[i]->file.seekg(0);
+			if (readRow(*runs[i]))
+				mergeHeap.push_back(i);
+		}
+
+		auto greater = [this](size_t left, size_t right) { return runs[right]->current.key < runs[left]->current.key; };
+		std::make_heap(mergeHeap.begin(), mergeHeap.end(), greater);
+
+		unique_ptr<Run> run = createRun();
+		SortEntry entry;
+		while (popRun(mergeHeap, entry))
+			writeRow(*run, entry.row);
+
+		run->file.flush();
+		if (!run->file)
+			throw std::exception("Couldn't write sort run!");
+
+		for (size_t i = 0; i < runs.size(); i++)
+			removeRun(*runs[i]);
+		runs.swap(merged);
+		runs.push_back(std::move(run));
+	}
+}
+
+bool Sort::nextSorted(SortEntry& entry)
+{
+	if (runs.empty())
+	{
+		if (ind == rows.size())
+			return false;
+
+		entry = std::move(rows[ind++]);
+		return true;
+	}
+
+	return popRun(heap, entry);
+}
+
+bool Sort::popRun(vector<size_t>& runHeap, SortEntry& entry)
+{
+	if (runHeap.empty())
+		return false;
+
+	auto greater = [this](size_t left, size_t right) { return runs[right]->current.key < runs[left]->current.key; };
+
+	// the root of the heap is the run with the smallest current row
+	std::pop_heap(runHeap.begin(), runHeap.end(), greater);
+	Run& run = *runs[runHeap.back()];
+	entry = std::move(run.current);
+
+	if (readRow(run))
+		std::push_heap(runHeap.begin(), runHeap.end(), greater);
+	else
+		runHeap.pop_back();
+
+	return true;
+}
+
+unique_ptr<Sort::Run> Sort::createRun()
+{
+	// the runs of other processes are in the same directory, so the names also get a random number picked once
+	static const uint64_t processTag = ((uint64_t)std::random_device()() << 32) | std::random_device()();
+	const std::filesystem::path dir = std::filesystem::temp_directory_path();
+
+	unique_ptr<Run> run = std::make_unique<Run>();
+	do
+	{
+		string name = "sort_" + std::to_string(processTag) + "_" + std::to_string(nextRunId++) + "_run.bin";
+		run->fileName = (dir / name).string();
+	} while (std::filesystem::exists(run->fileName));
+
+	run->file.open(run->fileName, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!run->file)
+		throw std::exception("Couldn't create sort run!");
+
+	runCount++;
+	return run;
+}
+
+void Sort::writeRow(Run& run, const Record& record)
+{
+	uint32_t length = record.encodedSize();
+	buffer.resize(length);
+	record.encode(buffer.data());
+
+	run.file.write((const char*)&length, sizeof(length));
+	run.file.write(buffer.data(), length);
+}
+
+bool Sort::readRow(Run& run)
+{
+	uint32_t length;
+	if (!run.file.read((char*)&length, sizeof(length)))
+		return false;
+
+	buffer.resize(length);
+	if (!run.file.read(buffer.data(), length))
+		throw std::exception("Couldn't read sort run!");
+
+	run.current.row = Record(buffer.data(), length);
+	makeKey(run.current, keys);
+	return true;
+}
+
+void Sort::removeRun(Run& run)
+{
+	if (run.fileName.empty())
+		return;
+
+	run.file.close();
+	std::remove(run.fileName.c_str());
+	run.fileName.clear();
+}
+
+TopK::TopK(unique_ptr<Operator> child, vector<SortKey> keys, size_t k)
+	: child(std::move(child))
+	, keys(std::move(keys))
+	, k(k)
+	, collected(false)
+	, ind(0)
+{}
+
+bool TopK::next(Record& record)
+{
+	if (!collected)
+	{
+		collect();
+		collected = true;
+	}
+
+	if (ind == rows.size())
+		return false;
+
+	record = std::move(rows[ind++].row);
+	return true;
+}
+
+void TopK::collect()
+{
+	if (k == 0)
+		return;
+
+	auto less = [](const SortEntry& left, const SortEntry& right) { return left.key < right.key; };
+
+	// the root of the heap is the biggest of the kept rows, so a smaller row replaces it
+	SortEntry entry;
+	while (child->next(entry.row))
+	{
+		Sort::makeKey(entry, keys);
+		if (rows.size() < k)
+		{
+			rows.push_back(std::move(entry));
+			std::push_heap(rows.begin(), rows.end(), less);
+		}
+		else if (less(entry, rows.front()))
+		{
+			std::pop_heap(rows.begin(), rows.end(), less);
+			rows.back() = std::move(entry);
+			std::push_heap(rows.begin(), rows.end(), less);
+		}
+	}
+
+	std::sort_heap(rows.begin(), rows.end(), less);
+}
+
+RowHashTable::RowHashTable()
+	: slots(16, { 0, 0 })
+	, width(0)
+	, bytes(0)
+{}
+
+std::pair<size_t, bool> RowHashTable::insert(const Record& record, const vector<size_t>& cols)
+{
+	if (hashes.empty())
+		width = cols.size();
+
+	uint64_t hash = hashRow(record, cols);
+	size_t pos = findSlot(record, cols, hash);
+	if (slots[pos].row != 0)
+		return { slots[pos].row - 1, false };
+
+	size_t row = hashes.size();
+	slots[pos] = { hash, (uint32_t)row + 1 };
+	hashes.push_back(hash);
+	bytes += sizeof(uint64_t) + width * sizeof(Data);
+	for (size_t i = 0; i < width; i++)
+	{
+		values.push_back(record.getColData(cols[i]));
+		bytes += values.back().encodedSize(false);
+	}
+
+	// the table is at most half full, so the probes stay short
+	if (2 * hashes.size() > slots.size())
+		grow();
+
+	return { row, true };
+}
+
+bool RowHashTable::contains(const Record& record, const vector<size_t>& cols) const
+{
+	return !hashes.empty() && slots[findSlot(record, cols, hashRow(record, cols))].row != 0;
+}
+
+uint64_t RowHashTable::hashRow(const Record& record, const vector<size_t>& cols)
+{
+	uint64_t hash = cols.size();
+	for (size_t i = 0; i < cols.size(); i++)
+		hash = (hash ^ record.getColData(cols[i]).hash()) * 0x100000001B3ull;
+
+	return hash;
+}
+
+size_t RowHashTable::findSlot(const Record& record, const vector<size_t>& cols, uint64_t hash) const
+{
+	size_t mask = slots.size() - 1;
+	size_t pos = hash & mask;
+
+	// the slots after the slot of the hash are checked until an empty one
+	for (; slots[pos].row != 0; pos = (pos + 1) & mask)
+	{
+		if (slots[pos].hash == hash && sameRow(record, cols, slots[pos].row - 1))
+			break;
+	}
+
+	return pos;
+}
+
+bool RowHashTable::sameRow(const Record& record, const vector<size_t>& cols, size_t row) const
+{
+	for (size_t i = 0; i < width; i++)
+	{
+		if (!record.getColData(cols[i]).equals(values[row * width + i]))
+			return false;
+	}
+
+	return true;
+}
+
+void RowHashTable::grow()
+{
+	slots.assign(2 * slots.size(), { 0, 0 });
+	size_t mask = slots.size() - 1;
+
+	for (size_t i = 0; i < hashes.size(); i++)
+	{
+		size_t pos = hashes[i] & mask;
+		while (slots[pos].row != 0)
+			pos = (pos + 1) & mask;
+
+		slots[pos] = { hashes[i], (uint32_t)i + 1 };
+	}
+}
+
+HashDistinct::HashDistinct(unique_ptr<Operator> child, size_t colCount, vector<SortKey> order)
+	: child(std::move(child))
+	, cols(colCount)
+	, order(std::move(order))
+{
+	for (size_t i = 0; i < colCount; i++)
+		cols[i] = i;
+}
+
+bool HashDistinct::next(Record& record)
+{
+	if (sorted != nullptr)
+		return sorted->next(record);
+
+	while (child->next(record))
+	{
+		if (!rows.insert(record, cols).second)
+			continue;
+
+		// the rows after this one are left out with sorts, so the kept rows take at most the memory budget
+		if (rows.getBytes() > Sort::getMemoryBudget())
+			sortRest();
+		return true;
+	}
+
+	return false;
+}
+
+void HashDistinct::sortRest()
+{
+	// the same rows are next to each other, the first one of them in the order is kept
+	vector<SortKey> keys;
+	for (size_t i = 0; i < cols.size(); i++)
+		keys.push_back({ cols[i], false });
+	keys.insert(keys.end(), order.begin(), order.end());
+
+	sorted = std::make_unique<Sort>(std::make_unique<PrintedDoubles>(std::move(child)), std::move(keys));
+	sorted = std::make_unique<SortedDistinct>(std::move(sorted), cols, rows);
+	if (!order.empty())
+		sorted = std::make_unique<Sort>(std::move(sorted), order);
+}
+
+PrintedDoubles::PrintedDoubles(unique_ptr<Operator> child)
+	: child(std::move(child))
+{}
+
+bool PrintedDoubles::next(Record& record)
+{
+	Record row;
+	if (!child->next(row))
+		return false;
+
+	record.clear();
+	for (size_t i = 0; i < row.size(); i++)
+	{
+		const Data& value = row.getColData(i);
+		if (value.getType() == DataType::Double)
+			record.addColumn(Data(Double::printed(value.toDouble())));
+		else
+			record.addColumn(value);
+	}
+
+	return true;
+}
+
+SortedDistinct::SortedDistinct(unique_ptr<Operator> child, vector<size_t> cols, const RowHashTable& given)
+	: child(std::move(child))
+	, cols(std::move(cols))
+	, given(given)
+	, hasLast(false)
+{}
+
+bool SortedDistinct::next(Record& record)
+{
+	while (child->next(record))
+	{
+		bool same = hasLast;
+		for (size_t i = 0; same && i < cols.size(); i++)
+			same = record.getColData(cols[i]).equals(last.getColData(cols[i]));
+		if (same)
+			continue;
+
+		last = record;
+		hasLast = true;
+		if (!given.contains(record, cols))
+			return true;
+	}
+
+	return false;
+}
+
+HashAggregate::HashAggregate(unique_ptr<Operator> child, vector<size_t> groupCols, vector<Aggregate> aggregates)
+	: child(std::move(child))
+	, groupCols(std::move(groupCols))
+	, aggregates(std::move(aggregates))
+	, built(false)
+	, ind(0)
+{}
+
+bool HashAggregate::next(Record& record)
+{
+	if (!built)
+		build();
+
+	if (ind == groups.size())
+		return false;
+
+	record = Record();
+	for (size_t i = 0; i < groupCols.size(); i++)
+		record.addColumn(groups.getValue(ind, i));
+
+	for (size_t i = 0; i < aggregates.size(); i++)
+		record.addColumn(result(accumulators[ind * aggregates.size() + i], aggregates[i].func));
+
+	ind++;
+	return true;
+}
+
+void HashAggregate::build()
+{
+	built = true;
+
+	Record row;
+	while (child->next(row))
+	{
+		std::pair<size_t, bool> group = groups.insert(row, groupCols);
+		if (group.second)
+			accumulators.resize(accumulators.size() + aggregates.size(), { 0, 0, 0.0, false, Data() });
+
+		Accumulator* acc = &accumulators[group.first * aggregates.size()];
+		for (size_t i = 0; i < aggregates.size(); i++)
+		{
+			if (aggregates[i].colInd == COUNT_ALL)
+				acc[i].count++;
+			else
+				accumulate(acc[i], aggregates[i].func, row.getColData(aggregates[i].colInd));
+		}
+	}
+
+	// the aggregates of all rows are given even if there are no rows
+	if (groupCols.empty() && groups.size() == 0)
+	{
+		groups.insert(Record(), groupCols);
+		accumulators.resize(aggregates.size(), { 0, 0, 0.0, false, Data() });
+	}
+}
+
+void HashAggregate::accumulate(Accumulator& acc, AggregateFunc func, const Data& value)
+{
+	if (value.isNull())
+		return;
+
+	acc.count++;
+	switch (func)
+	{
+	case AggregateFunc::Sum:
+	case AggregateFunc::Avg:
+		if (value.getType() == DataType::Int)
+			acc.intSum += value.toInteger();
+		else
+		{
+			acc.doubleSum += value.toDouble();
+			acc.hasDouble = true;
+		}
+		break;
+	case AggregateFunc::Min:
+		if (acc.extreme.isNull() || value < acc.extreme)
+			acc.extreme = value;
+		break;
+	case AggregateFunc::Max:
+		if (acc.extreme.isNull() || value > acc.extreme)
+			acc.extreme = value;
+		break;
+	default:
+		break;
+	}
+}
+
+Data HashAggregate::result(const Accumulator& acc, AggregateFunc func)
+{
+	if (func == AggregateFunc::Count)
+		return Data((int)acc.count);
+	if (acc.count == 0)
+		return Data();
+
+	switch (func)
+	{
+	case AggregateFunc::Sum:
+		// the sum of Int values stays Int unless it doesn't fit in one
+		if (!acc.hasDouble && acc.intSum >= INT_MIN && acc.intSum <= INT_MAX)
+			return Data((int)acc.intSum);
+		return Data((double)acc.intSum + acc.doubleSum);
+	case AggregateFunc::Avg:
+		return Data(((double)acc.intSum + acc.doubleSum) / acc.count);
+	default:
+		return acc.extreme;
+	}
+}
+
+Limit::Limit(unique_ptr<Operator> child, size_t count)
+	: child(std::move(child))
+	, count(count)
+	, passed(0)
+{}
+
+bool Limit::next(Record& record)
+{
+	if (passed == count || !child->next(record))
+		return false;
+
+	passed++;
+	return true;
+}
+
+Project::Project(unique_ptr<Operator> child, vector<size_t> colInds)
+	: child(std::move(child))
+	, colInds(std::move(colInds))
+{}
+
+bool Project::next(Record& record)
+{
+	Record row;
+	if (!child->next(row))
+		return false;
+
+	record.clear();
+	for (size_t i = 0; i < colInds.size(); i++)
+		record.addColumn(row.getColData(colInds[i]));
+
+	return true;
+}
@@ -0,0 +1,559 @@
+#pragma once
+#include "BPlusTree.h"
+#include "BufferPool.h"
+#include "RecordPtr.h"
+#include "RowBitmap.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using std::vector;
+using std::unique_ptr;
+using std::function;
+
+/// @brief A stage of the pipeline of a select (Volcano model). Every stage pulls the rows it needs
+/// from the stage before it one at a time, so a row can reach the end of the pipeline before the rest
+/// of the table is read. Only the stages that need all rows (like Sort) keep them in memory.
+
+class Operator
+{
+public:
+	virtual ~Operator() = default;
+
+	/// @brief Gives the next row of the stage
+	/// @param record - set to the next row
+	/// @return false if there are no more rows and true otherwise
+	virtual bool next(Record& record) = 0;
+
+	/// @brief Gives a row in the string format it is printed in (the values separated by spaces)
+	/// @param record - the row
+	/// @return the row in string format
+	static string toRow(const Record& record);
+};
+
+/// @brief Reads all rows of a table in the order they are stored, one page at a time
+
+class TableScan : public Operator
+{
+public:
+	/// @param table - the name of the table
+	/// @param lastPage - the number of the last page of the table (the pages are numbered from 1)
+	/// @param skipPage - tells if a page can be skipped without reading it (no page is skipped if it is empty)
+	TableScan(const string& table, size_t lastPage, function<bool(size_t)> skipPage = nullptr);
+
+	bool next(Record& record) override;
+
+private:
+	string table;
+	size_t lastPage;
+	function<bool(size_t)> skipPage;
+	size_t pageNum;
+	vector<Record> batch; // the rows of the current page
+	size_t ind;
+};
+
+/// @brief Reads the rows at given positions (found through an index), one page at a time
+
+class IndexFetch : public Operator
+{
+public:
+	/// @param table - the name of the table
+	/// @param recordPtrs - the positions of the rows (they are sorted by page and row if they aren't)
+	IndexFetch(const string& table, vector<RecordPtr> recordPtrs);
+
+	bool next(Record& record) override;
+
+private:
+	string table;
+	vector<RecordPtr> recordPtrs;
+	size_t pos; // the first position that isn't in the batch
+	vector<Record> batch; // the rows of the current page
+	size_t ind;
+};
+
+/// @brief The values of an index that a scan walks (a bound with no value doesn't limit the walk)
+struct IndexBounds
+{
+	Data from;
+	Data to;
+};
+
+/// @brief Reads given rows of a table in the order of an index (walking its leaves), so they don't have to be sorted
+
+class IndexScan : public Operator
+{
+public:
+	/// @param table - the name of the table
+	/// @param index - the index that gives the order of the rows
+	/// @param rows - the rows
+	/// @param bounds - the values of the index that are walked
+	IndexScan(const string& table, const BPlusTree& index, const RowBitmap& rows, const IndexBounds& bounds = IndexBounds());
+
+	bool next(Record& record) override;
+
+private:
+	string table;
+	RowBitmap rows;
+	BPlusTree::Cursor cursor;
+};
+
+/// @brief Gives the values of given rows from indexes only, without reading the pages of the table
+/// (every column of the rows has to be indexed). Every index is walked only between the bounds of its column.
+/// The values of one column are given as the leaves are walked (in the order of the index), so a LIMIT
+/// stops the walk. The values of more columns are put together by row before the first row is given,
+/// and the rows are given in the order they are stored or in the order of one of the indexes.
+
+class IndexOnlyScan : public Operator
+{
+public:
+	/// @param rows - the rows
+	/// @param indexes - the index of every column of the rows
+	/// @param bounds - the bounds of every index (empty for no bounds)
+	/// @param orderCol - the column whose index gives the order of the rows (NO_ORDER for the order they are stored)
+	IndexOnlyScan(const RowBitmap& rows, vector<const BPlusTree*> indexes, vector<IndexBounds> bounds = {},
+		size_t orderCol = NO_ORDER);
+
+	static const size_t NO_ORDER = SIZE_MAX;
+
+	bool next(Record& record) override;
+
+private:
+	/// @brief Starts a walk of the leaves of an index between its bounds
+	/// @param j - the column of the index
+	/// @return cursor to the first element
+	BPlusTree::Cursor walk(size_t j) const;
+
+	/// @brief Walks the leaves of every index and keeps the values of the rows
+	void collect();
+
+private:
+	RowBitmap rows;
+	vector<const BPlusTree*> indexes;
+	vector<IndexBounds> bounds;
+	BPlusTree::Cursor cursor; // the walk of the index of a single column
+	bool collected;
+	vector<RecordPtr> recordPtrs;
+	vector<vector<Data>> columns; // columns[j][i] is the value of the j-th column of the i-th row
+	size_t orderCol;
+	vector<size_t> order; // the rows in the order of the index of orderCol
+	size_t ind;
+};
+
+/// @brief Passes only the rows that satisfy a condition
+
+class Filter : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param condition - returns true for the rows that are passed
+	Filter(unique_ptr<Operator> child, function<bool(const Record&)> condition);
+
+	bool next(Record& record) override;
+
+private:
+	unique_ptr<Operator> child;
+	function<bool(const Record&)> condition;
+};
+
+const size_t DEFAULT_SORT_MEMORY = 64 * 1024 * 1024;
+const size_t MAX_MERGED_RUNS = 64; // the most runs that are merged at once
+const size_t MIN_ROWS_PER_SORT_TASK = 16384; // fewer rows are sorted by one thread
+
+/// @brief A column the rows are sorted by
+struct SortKey
+{
+	size_t colInd;
+	bool descending;
+};
+
+/// @brief A row with its sort key - the sort keys of the values of the columns of the order, appended
+/// (see Data::appendSortKey), so the rows are compared with memcmp instead of comparing the values
+
+struct SortEntry
+{
+	string key;
+	Record row;
+};
+
+/// @brief Sorts the rows by some columns. All rows of the stage before it are read on the first call of next.
+/// The rows are kept in memory until they take more than the memory budget of the sorts, then they are sorted
+/// and written to a run file (every row in the format of a page record, after its length). The runs are merged
+/// with a heap of their first rows while the rows are given, so only one row of every run is in memory.
+/// The rows in memory are split between the threads of the thread pool, every thread builds the keys of its rows
+/// and sorts them, then the sorted parts are merged in parallel.
+
+class Sort : public Operator
+{
+	/// @brief A sorted run of rows written to a temporary file
+	struct Run
+	{
+		string fileName;
+		std::fstream file;
+		SortEntry current; // the first row of the run that isn't given yet
+	};
+
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param keys - the columns the rows are sorted by, the first one is compared first
+	Sort(unique_ptr<Operator> child, vector<SortKey> keys);
+	~Sort();
+
+	bool next(Record& record) override;
+
+	/// @brief Sets the memory the rows of a sort may take before they are written to a run file
+	/// @param bytes - the memory budget
+	static void setMemoryBudget(size_t bytes);
+
+	static size_t getMemoryBudget() { return memoryBudget; }
+
+	/// @brief Gets the number of runs the sort wrote to files
+	/// @return the number of runs
+	inline size_t getRunCount() const { return runCount; }
+
+	/// @brief Builds the sort key of a row
+	/// @param entry - the row, its key is set
+	/// @param keys - the columns the rows are sorted by
+	static void makeKey(SortEntry& entry, const vector<SortKey>& keys);
+
+	/// @brief Builds the sort keys of rows and sorts the rows by them, in parallel on the thread pool
+	/// @param entries - the rows
+	/// @param keys - the columns the rows are sorted by
+	static void sortEntries(vector<SortEntry>& entries, const vector<SortKey>& keys);
+
+private:
+	/// @brief Reads all rows of the child, writing them to runs when they don't fit in the memory budget
+	void collect();
+
+	/// @brief Sorts the rows in memory and writes them to a new run
+	void spill();
+
+	/// @brief Merges the first runs into one run until they can be merged at once
+	void mergeRuns();
+
+	/// @brief Gives the next row in the order of the keys
+	/// @param entry - the row
+	/// @return false if there are no more rows and true otherwise
+	bool nextSorted(SortEntry& entry);
+
+	/// @brief Gives the next row from the heap of runs
+	/// @param runHeap - the indexes of the runs that have rows, as a heap by their current row
+	/// @param entry - the row
+	/// @return false if the runs have no more rows and true otherwise
+	bool popRun(vector<size_t>& runHeap, SortEntry& entry);
+
+	/// @brief Creates a run file with a new name in the temporary directory to write rows to
+	/// @return the run
+	unique_ptr<Run> createRun();
+
+	/// @brief Writes a row to the end of a run
+	/// @param run - the run
+	/// @param record - the row
+	void writeRow(Run& run, const Record& record);
+
+	/// @brief Reads the next row of a run in its current row
+	/// @param run - the run
+	/// @return false if the run has no more rows and true otherwise
+	bool readRow(Run& run);
+
+	/// @brief Closes a run and removes its file
+	/// @param run - the run
+	void removeRun(Run& run);
+
+private:
+	unique_ptr<Operator> child;
+	vector<SortKey> keys;
+	bool sorted;
+	vector<SortEntry> rows; // the rows in memory
+	size_t rowsBytes; // the memory taken by the rows in memory
+	size_t ind;
+	vector<unique_ptr<Run>> runs;
+	vector<size_t> heap; // the runs that have rows, as a heap by their current row
+	size_t runCount;
+	vector<char> buffer; // the encoded form of a row of a run
+
+	static size_t memoryBudget;
+	static size_t nextRunId; // makes the names of the run files of the process unique
+};
+
+/// @brief Keeps the first k rows in the order of some columns. Only k rows are kept in a heap while the rows
+/// of the stage before it are read, so it needs O(k) memory and O(n log k) time instead of sorting all rows.
+
+class TopK : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param keys - the columns the rows are sorted by, the first one is compared first
+	/// @param k - the number of rows
+	TopK(unique_ptr<Operator> child, vector<SortKey> keys, size_t k);
+
+	bool next(Record& record) override;
+
+private:
+	/// @brief Reads all rows of the child keeping the first k, then sorts them
+	void collect();
+
+private:
+	unique_ptr<Operator> child;
+	vector<SortKey> keys;
+	size_t k;
+	bool collected;
+	vector<SortEntry> rows; // a max-heap by the key while the rows are collected
+	size_t ind;
+};
+
+/// @brief A flat open-addressing hash table of rows (linear probing over the hashes of the rows). Only the values
+/// of the key columns of a row are kept, so a row is compared by its typed values without building a string.
+/// The kept rows are numbered in the order they are first inserted.
+
+class RowHashTable
+{
+	/// @brief A slot of the hash table
+	struct Slot
+	{
+		uint64_t hash;
+		uint32_t row; // the number of the kept row + 1 or 0 for an empty slot
+	};
+
+public:
+	RowHashTable();
+
+	/// @brief Finds the kept row with the same values of the key columns as a row and keeps the row if there is none
+	/// @param record - the row
+	/// @param cols - the key columns of the row (the same number of columns for every row)
+	/// @return the number of the kept row and true if the row was kept now or false if it was found
+	std::pair<size_t, bool> insert(const Record& record, const vector<size_t>& cols);
+
+	/// @brief Gets a value of a kept row
+	/// @param row - the number of the kept row
+	/// @param col - the index of the column in the key columns
+	/// @return the value
+	inline const Data& getValue(size_t row, size_t col) const { return values[row * width + col]; }
+
+	/// @brief Checks if there is a kept row with the same values of the key columns as a row
+	/// @param record - the row
+	/// @param cols - the key columns of the row
+	/// @return true if there is such a row and false otherwise
+	bool contains(const Record& record, const vector<size_t>& cols) const;
+
+	/// @brief Gets the number of the kept rows
+	inline size_t size() const { return hashes.size(); }
+
+	/// @brief Gets the memory taken by the table
+	/// @return the size in bytes
+	inline size_t getBytes() const { return slots.size() * sizeof(Slot) + bytes; }
+
+private:
+	/// @brief Hashes the values of the key columns of a row
+	/// @param record - the row
+	/// @param cols - the key columns
+	/// @return the hash
+	static uint64_t hashRow(const Record& record, const vector<size_t>& cols);
+
+	/// @brief Finds the slot of the kept row with the same values of the key columns as a row
+	/// @param record - the row
+	/// @param cols - the key columns
+	/// @param hash - the hash of the row
+	/// @return the slot of the row or the empty slot it would take
+	size_t findSlot(const Record& record, const vector<size_t>& cols, uint64_t hash) const;
+
+	/// @brief Checks if a row has the same values of the key columns as a kept row
+	/// @param record - the row
+	/// @param cols - the key columns
+	/// @param row - the number of the kept row
+	/// @return true if the values are the same and false otherwise
+	bool sameRow(const Record& record, const vector<size_t>& cols, size_t row) const;
+
+	/// @brief Doubles the slots of the table and puts the kept rows in them again
+	void grow();
+
+private:
+	vector<Slot> slots; // the size is a power of 2
+	vector<uint64_t> hashes; // the hash of every kept row
+	vector<Data> values; // the values of the key columns of the kept rows, one row after another
+	size_t width; // the number of the key columns
+	size_t bytes; // the memory taken by the kept rows
+};
+
+/// @brief Leaves out the rows that are the same as an earlier row in the first columns. The kept rows are in
+/// a RowHashTable and a row is given as soon as it is first seen, so the order of the stage before it is kept
+/// and a LIMIT stops the reading after the first rows. When the kept rows take more than the memory budget of
+/// the sorts, the rest of the rows are left out with external sorts instead: they are sorted by the compared
+/// columns and the order, the first of the same rows that wasn't given yet is kept and the kept rows are sorted
+/// by the order again. These rows come after the given ones in the order (or in the order of the compared
+/// columns if there is none) and all of them are read before the first one is given.
+
+class HashDistinct : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param colCount - the number of the first columns that are compared
+	/// @param order - the columns the rows of the stage before are ordered by (empty if they aren't ordered)
+	HashDistinct(unique_ptr<Operator> child, size_t colCount, vector<SortKey> order = {});
+
+	bool next(Record& record) override;
+
+	/// @brief Gets the number of the rows kept in memory
+	inline size_t size() const { return rows.size(); }
+
+	/// @brief Checks if the rest of the rows are left out with sorts
+	inline bool isSorted() const { return sorted != nullptr; }
+
+private:
+	/// @brief Builds the sorts that leave out the same rows from the rest of the rows
+	void sortRest();
+
+private:
+	unique_ptr<Operator> child;
+	vector<size_t> cols; // the compared columns
+	vector<SortKey> order;
+	RowHashTable rows;
+	unique_ptr<Operator> sorted; // the rest of the rows, once the kept rows don't fit in memory
+};
+
+/// @brief Gives the rows of the stage before it with every Double replaced by the value it is printed as,
+/// so the rows that are the same are next to each other after a sort
+
+class PrintedDoubles : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	PrintedDoubles(unique_ptr<Operator> child);
+
+	bool next(Record& record) override;
+
+private:
+	unique_ptr<Operator> child;
+};
+
+/// @brief Leaves out the rows of a stage sorted by the compared columns that are the same as the row before them
+/// or as a row kept in a RowHashTable
+
+class SortedDistinct : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param cols - the compared columns
+	/// @param given - the rows that are already given
+	SortedDistinct(unique_ptr<Operator> child, vector<size_t> cols, const RowHashTable& given);
+
+	bool next(Record& record) override;
+
+private:
+	unique_ptr<Operator> child;
+	vector<size_t> cols;
+	const RowHashTable& given;
+	Record last; // the row before
+	bool hasLast;
+};
+
+/// @brief The functions of the aggregates
+enum class AggregateFunc
+{
+	Count,
+	Sum,
+	Avg,
+	Min,
+	Max
+};
+
+const size_t COUNT_ALL = SIZE_MAX; // the column of COUNT(*), which counts the rows
+
+/// @brief An aggregate of a column
+struct Aggregate
+{
+	AggregateFunc func;
+	size_t colInd;
+};
+
+/// @brief Groups the rows by some columns and computes aggregates (COUNT, SUM, AVG, MIN and MAX) for every group.
+/// The groups are kept in a RowHashTable and every group has a typed accumulator for every aggregate, so only
+/// one row of values for every group is in memory while the rows are read. All rows of the stage before it are
+/// read on the first call of next, then a row is given for every group (in the order the groups are first seen):
+/// the values of the group columns followed by the aggregates. Without group columns there is one row even if
+/// there are no rows (COUNT is 0 and the other aggregates have no value).
+
+class HashAggregate : public Operator
+{
+	/// @brief The running value of an aggregate in a group
+	struct Accumulator
+	{
+		size_t count; // the number of the values (or the rows for COUNT(*))
+		int64_t intSum; // the sum of the Int values
+		double doubleSum; // the sum of the rest of the values
+		bool hasDouble; // true if a value wasn't Int
+		Data extreme; // the smallest or biggest value for MIN and MAX
+	};
+
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param groupCols - the indexes of the columns the rows are grouped by
+	/// @param aggregates - the aggregates, their columns are indexes in the rows of the child
+	HashAggregate(unique_ptr<Operator> child, vector<size_t> groupCols, vector<Aggregate> aggregates);
+
+	bool next(Record& record) override;
+
+	/// @brief Gets the number of the groups
+	inline size_t size() const { return groups.size(); }
+
+private:
+	/// @brief Reads all rows of the stage before and adds them to their groups
+	void build();
+
+	/// @brief Adds a value to an accumulator
+	/// @param acc - the accumulator
+	/// @param func - the function of the aggregate
+	/// @param value - the value
+	static void accumulate(Accumulator& acc, AggregateFunc func, const Data& value);
+
+	/// @brief Gives the result of an accumulator
+	/// @param acc - the accumulator
+	/// @param func - the function of the aggregate
+	/// @return the result (with no value if the group has no values and the function isn't COUNT)
+	static Data result(const Accumulator& acc, AggregateFunc func);
+
+private:
+	unique_ptr<Operator> child;
+	vector<size_t> groupCols;
+	vector<Aggregate> aggregates;
+	RowHashTable groups;
+	vector<Accumulator> accumulators; // the accumulators of every group, one group after another
+	bool built;
+	size_t ind; // the group that is given next
+};
+
+/// @brief Passes only the first given number of rows and stops reading the stage before it after them
+
+class Limit : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param count - the number of rows
+	Limit(unique_ptr<Operator> child, size_t count);
+
+	bool next(Record& record) override;
+
+private:
+	unique_ptr<Operator> child;
+	size_t count;
+	size_t passed;
+};
+
+/// @brief Keeps only given columns of the rows, in the given order
+
+class Project : public Operator
+{
+public:
+	/// @param child - the stage the rows are taken from
+	/// @param colInds - the indexes of the columns that are kept
+	Project(unique_ptr<Operator> child, vector<size_t> colInds);
+
+	bool next(Record& record) override;
+
+private:
+	unique_ptr<Operator> child;
+	vector<size_t> colInds;
+};
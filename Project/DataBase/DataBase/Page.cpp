@@ -1,54 +1,307 @@
-#include "Page.h"
-
-Page::Page(size_t max)
-	: maxRecordsSize(max)
-{}
-
-Page::Page(std::ifstream& in)
-{
-	in.read((char*)&maxRecordsSize, sizeof(maxRecordsSize));
-
-	size_t len;
-	in.read((char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		recordVec.push_back(Record(in));
-	}
-}
-
-void Page::addRecord(const Record& record)
-{
-	if (isFull())
-		throw std::overflow_error("Page is full");
-
-	recordVec.push_back(record);
-}
-
-void Page::removeRecord(size_t index)
-{
-	if (index < 0 || index >= recordVec.size())
-		throw std::invalid_argument("Record index out of bounds");
-
-	recordVec[index].clear();
-}
-
-Record Page::getRecord(size_t index)
-{
-	if (index < 0 || index >= recordVec.size())
-		throw std::exception("Record index out of bounds");
-
-	return recordVec[index];
-}
-
-void Page::serialize(std::ofstream& out) const
-{
-	out.write((const char*)&maxRecordsSize, sizeof(maxRecordsSize));
-
-	size_t len = recordVec.size();
-	out.write((const char*)&len, sizeof(len));
-
-	for (size_t i = 0; i < len; i++)
-	{
-		recordVec[i].serialize(out);
-	}
-}
+#include "Page.h"
+#include <cstring>
+
+Page::Page(size_t max, size_t pageSize, const std::vector<DataType>& types)
+	: image(pageSize, 0)
+	, types(types)
+{
+	if (pageSize < sizeof(Header) + types.size() + sizeof(Slot))
+		throw std::invalid_argument("Page size is too small!");
+
+	header.magic = PAGE_MAGIC;
+	header.version = PAGE_VERSION;
+	header.slotsCount = 0;
+	header.pageSize = pageSize;
+	header.maxRecords = max;
+	header.dataStart = pageSize;
+	header.liveRecords = 0;
+	header.typesCount = types.size();
+	header.reserved = 0;
+
+	for (size_t i = 0; i < types.size(); i++)
+		image[sizeof(Header) + i] = (char)types[i];
+}
+
+Page::Page(std::istream& in)
+{
+	in.read((char*)&header, sizeof(header));
+	if (!in || header.magic != PAGE_MAGIC)
+		throw std::exception("Invalid page file!");
+	if (header.version != PAGE_VERSION)
+		throw std::exception("Unsupported page version!");
+
+	image.resize(header.pageSize);
+	std::memcpy(&image[0], &header, sizeof(header));
+	in.read(&image[sizeof(header)], header.pageSize - sizeof(header));
+
+	types.reserve(header.typesCount);
+	for (size_t i = 0; i < header.typesCount; i++)
+		types.push_back((DataType)(uint8_t)image[sizeof(Header) + i]);
+}
+
+Page Page::load(std::ifstream& in, bool& converted)
+{
+	converted = !isPageImage(in);
+	if (converted)
+		return fromLegacy(in);
+
+	uint32_t magic;
+	uint16_t version;
+	std::streampos start = in.tellg();
+	in.read((char*)&magic, sizeof(magic));
+	in.read((char*)&version, sizeof(version));
+	in.seekg(start);
+
+	if (version == PAGE_VERSION)
+		return Page(in);
+
+	converted = true;
+	return fromVersion1(in);
+}
+
+Page Page::fromLegacy(std::ifstream& in)
+{
+	size_t maxRecordsSize;
+	in.read((char*)&maxRecordsSize, sizeof(maxRecordsSize));
+
+	size_t len;
+	in.read((char*)&len, sizeof(len));
+
+	std::vector<Record> records;
+	records.reserve(len);
+	size_t needed = sizeof(Header);
+	for (size_t i = 0; i < len; i++)
+	{
+		records.push_back(Record::fromLegacy(in));
+		needed += sizeof(Slot) + (records[i].isEmpty() ? 0 : records[i].encodedSize());
+	}
+
+	// old pages had no size limit, so a page may need more than one PAGE_SIZE
+	size_t pageSize = (needed + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+	Page page(std::max(maxRecordsSize, len), std::max(pageSize, PAGE_SIZE));
+
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		if (records[i].isEmpty())
+		{
+			// keep the removed records as empty slots so the record pointers stay valid
+			page.writeSlot(page.header.slotsCount, { 0, 0 });
+			page.header.slotsCount++;
+		}
+		else
+			page.addRecord(records[i]);
+	}
+
+	return page;
+}
+
+Page Page::fromVersion1(std::ifstream& in)
+{
+	// version 1 had the same fields without the types count, so the header was 24 bytes
+	const size_t headerSize = 24;
+	uint32_t fields[6];
+	in.read((char*)fields, headerSize);
+	if (!in)
+		throw std::exception("Invalid page file!");
+
+	uint16_t slotsCount;
+	std::memcpy(&slotsCount, (const char*)fields + 6, sizeof(slotsCount));
+	size_t pageSize = fields[2];
+
+	std::vector<char> old(pageSize);
+	in.read(&old[headerSize], pageSize - headerSize);
+
+	Page page(fields[3], pageSize);
+	for (size_t i = 0; i < slotsCount; i++)
+	{
+		Slot slot;
+		std::memcpy(&slot, &old[headerSize + i * sizeof(Slot)], sizeof(Slot));
+		if (slot.length == 0)
+		{
+			page.writeSlot(page.header.slotsCount, { 0, 0 });
+			page.header.slotsCount++;
+			continue;
+		}
+
+		// the records were saved with a column count and the type name of every value
+		uint16_t len;
+		std::memcpy(&len, &old[slot.offset], sizeof(len));
+		size_t offset = slot.offset + sizeof(len);
+
+		Record record;
+		for (size_t j = 0; j < len; j++)
+			record.addColumn(Data::fromLegacy(&old[0], offset));
+		page.addRecord(record);
+	}
+
+	return page;
+}
+
+bool Page::isPageImage(std::ifstream& in)
+{
+	uint32_t magic = 0;
+	std::streampos start = in.tellg();
+	in.read((char*)&magic, sizeof(magic));
+	in.clear();
+	in.seekg(start);
+
+	return magic == PAGE_MAGIC;
+}
+
+void Page::addRecord(const Record& record)
+{
+	if (isFull())
+		throw std::overflow_error("Page is full");
+
+	if (isTyped() && !record.matches(types))
+		throw std::invalid_argument("Record doesn't match the columns of the page!");
+
+	size_t length = record.encodedSize(!isTyped());
+	if (freeSpace() < length + sizeof(Slot))
+		throw std::overflow_error("Not enough space in the page");
+
+	header.dataStart -= length;
+	record.encode(&image[header.dataStart], !isTyped());
+
+	writeSlot(header.slotsCount, { header.dataStart, (uint32_t)length });
+	header.slotsCount++;
+	header.liveRecords++;
+}
+
+size_t Page::insertRecord(const Record& record)
+{
+	if (!hasEmptySlot())
+	{
+		if (freeSpace() < record.encodedSize(!isTyped()) + sizeof(Slot) && canInsert(record))
+			compact();
+
+		addRecord(record);
+		return header.slotsCount - 1;
+	}
+
+	if (isTyped() && !record.matches(types))
+		throw std::invalid_argument("Record doesn't match the columns of the page!");
+
+	size_t length = record.encodedSize(!isTyped());
+	if (freeSpace() < length)
+	{
+		if (length > availableSpace())
+			throw std::overflow_error("Not enough space in the page");
+		compact();
+	}
+
+	size_t index = 0;
+	while (readSlot(index).length != 0)
+		index++;
+
+	header.dataStart -= length;
+	record.encode(&image[header.dataStart], !isTyped());
+
+	writeSlot(index, { header.dataStart, (uint32_t)length });
+	header.liveRecords++;
+
+	return index;
+}
+
+void Page::removeRecord(size_t index)
+{
+	if (index >= header.slotsCount)
+		throw std::invalid_argument("Record index out of bounds");
+
+	Slot slot = readSlot(index);
+	if (slot.length == 0)
+		return;
+
+	writeSlot(index, { 0, 0 });
+	header.liveRecords--;
+}
+
+Record Page::getRecord(size_t index) const
+{
+	if (index >= header.slotsCount)
+		throw std::exception("Record index out of bounds");
+
+	Slot slot = readSlot(index);
+	if (slot.length == 0)
+		return Record();
+
+	return Record(&image[slot.offset], slot.length, types);
+}
+
+void Page::serialize(std::ostream& out) const
+{
+	out.write((const char*)&header, sizeof(header));
+	out.write(&image[sizeof(header)], image.size() - sizeof(header));
+}
+
+bool Page::isFull() const
+{
+	if (header.maxRecords != 0 && header.slotsCount == header.maxRecords)
+		return true;
+
+	// the slot count is 16 bits, and the smallest record takes at least one byte
+	return header.slotsCount == UINT16_MAX || freeSpace() <= sizeof(Slot);
+}
+
+bool Page::canAdd(const Record& record) const
+{
+	return !isFull() && freeSpace() >= record.encodedSize(!isTyped()) + sizeof(Slot);
+}
+
+bool Page::canInsert(const Record& record) const
+{
+	size_t length = record.encodedSize(!isTyped());
+
+	// the free space between the slots and the records is checked first, so the records are summed only if it isn't enough
+	if (hasEmptySlot() ? freeSpace() >= length : canAdd(record))
+		return true;
+
+	return length <= availableSpace();
+}
+
+size_t Page::availableSpace() const
+{
+	bool newSlot = !hasEmptySlot();
+	if (newSlot && (header.slotsCount == UINT16_MAX || (header.maxRecords != 0 && header.slotsCount == header.maxRecords)))
+		return 0;
+
+	size_t used = slotsStart() + (header.slotsCount + newSlot) * sizeof(Slot);
+	for (size_t i = 0; i < header.slotsCount; i++)
+		used += readSlot(i).length;
+
+	return used < header.pageSize ? header.pageSize - used : 0;
+}
+
+void Page::compact()
+{
+	std::vector<char> old(image);
+	header.dataStart = header.pageSize;
+
+	for (size_t i = 0; i < header.slotsCount; i++)
+	{
+		Slot slot = readSlot(i);
+		if (slot.length == 0)
+			continue;
+
+		header.dataStart -= slot.length;
+		std::memcpy(&image[header.dataStart], &old[slot.offset], slot.length);
+		writeSlot(i, { header.dataStart, slot.length });
+	}
+}
+
+size_t Page::freeSpace() const
+{
+	return header.dataStart - slotsStart() - header.slotsCount * sizeof(Slot);
+}
+
+Page::Slot Page::readSlot(size_t index) const
+{
+	Slot slot;
+	std::memcpy(&slot, &image[slotsStart() + index * sizeof(Slot)], sizeof(Slot));
+	return slot;
+}
+
+void Page::writeSlot(size_t index, const Slot& slot)
+{
+	std::memcpy(&image[slotsStart() + index * sizeof(Slot)], &slot, sizeof(Slot));
+}
@@ -1,49 +1,161 @@
-#pragma once
-#include <unordered_map>
-#include "Record.h"
-
-/// @brief A class representing a file with given size. It holds a vector of Records.
-
-class Page
-{
-public:
-	Page(size_t max = 10);
-
-	/// @brief Deserializing constructor
-	/// @param in - the file that the object will be read from
-	Page(std::ifstream& in);
-
-	/// @brief Adds a record into the records vector
-	/// @param record - the record to add
-	void addRecord(const Record& record);
-
-	/// @brief Clears a record from the vector at a given index but doesn't remove it from the vector keeping the order of indexes in the vector 
-	/// @param index - the index where a record will be cleared
-	void removeRecord(size_t index);
-
-	/// @brief Gets the record at a given index from the vector
-	/// @param index - the index of the record
-	/// @return the record at the index
-	Record getRecord(size_t index);
-	
-	/// @brief Saves the page to a file in a binary format
-	/// @param out - the file
-	void serialize(std::ofstream& out) const;
-
-	/// @brief Checks if the page (the vector of records) is full
-	/// @return true if the size of the vector is the max size of the page and false otherwise
-	inline bool isFull() const { return recordVec.size() == maxRecordsSize; }
-
-	/// @brief Checks if the page (the vector of records) is empty
-	/// @return true if the vector is empty
-	inline bool isEmpty() const { return recordVec.size() == 0; }
-
-	/// @brief Gets the ammount of records in the vector (counting the empty ones)
-	/// @return the size of the vector
-	inline size_t size() { return recordVec.size(); }
-
-private:
-	size_t maxRecordsSize;
-	std::vector<Record> recordVec;
-};
-
+#pragma once
+#include <cstdint>
+#include "Record.h"
+
+const size_t PAGE_SIZE = 4096;
+const size_t MAX_PAGE_SIZE = 64 * 1024;
+const uint32_t PAGE_MAGIC = 0x47504D46; // "FMPG"
+const uint16_t PAGE_VERSION = 2;
+
+/// @brief A class representing a fixed size page of a table in slotted format.
+/// The page image starts with a header, followed by a directory of slots (offset and length of every record)
+/// and the records are stored from the end of the page backwards. The image is the same in memory and in the file,
+/// so a record is read directly from it through its slot without reading the records before it.
+/// A page may know the types of its columns (saved after the header) and then its records are stored
+/// without the column count and the type tags of the values.
+
+class Page
+{
+	/// @brief The beginning of the page image
+	struct Header
+	{
+		uint32_t magic;
+		uint16_t version;
+		uint16_t slotsCount;
+		uint32_t pageSize;
+		uint32_t maxRecords;
+		uint32_t dataStart; // offset of the first byte of the records
+		uint32_t liveRecords;
+		uint16_t typesCount; // the types of the columns are saved after the header
+		uint16_t reserved;
+	};
+
+	/// @brief Position of a record in the page image (a slot with length 0 is empty)
+	struct Slot
+	{
+		uint32_t offset;
+		uint32_t length;
+	};
+
+public:
+	/// @brief Creates an empty page
+	/// @param max - the max number of records (0 if only the size of the page limits them)
+	/// @param pageSize - the size of the page image
+	/// @param types - the types of the columns of the records (empty if the records are stored with their types)
+	Page(size_t max = 0, size_t pageSize = PAGE_SIZE, const std::vector<DataType>& types = {});
+
+	/// @brief Deserializing constructor
+	/// @param in - the file that the page image will be read from
+	Page(std::istream& in);
+
+	/// @brief Reads a page from a file, converting it if it is in an older format
+	/// @param in - the file
+	/// @param converted - set to true if the page was in an older format and has to be written again
+	/// @return the read page
+	static Page load(std::ifstream& in, bool& converted);
+
+	/// @brief Converts a page saved in the old format (a stream of records) to a page image
+	/// @param in - the file that the old page will be read from
+	/// @return the converted page
+	static Page fromLegacy(std::ifstream& in);
+
+	/// @brief Checks if a file starts with a page image and not with a page in the old format
+	/// @param in - the file
+	/// @return true if the file contains a page image and false otherwise
+	static bool isPageImage(std::ifstream& in);
+
+	/// @brief Adds a record into the first free slot at the end of the slot directory
+	/// @param record - the record to add
+	void addRecord(const Record& record);
+
+	/// @brief Adds a record into the first empty slot (left by a removed record) or into a new slot if there is none.
+	/// The records are moved together first if the free space between them isn't enough, their slots stay the same.
+	/// @param record - the record to add
+	/// @return the index of the slot of the record
+	size_t insertRecord(const Record& record);
+
+	/// @brief Clears the slot of a record but doesn't remove it from the directory keeping the order of indexes in the page
+	/// @param index - the index where a record will be cleared
+	void removeRecord(size_t index);
+
+	/// @brief Reads the record at a given slot from the page image
+	/// @param index - the index of the record
+	/// @return the record at the index (empty if it was removed)
+	Record getRecord(size_t index) const;
+
+	/// @brief Saves the page image to a file
+	/// @param out - the file
+	void serialize(std::ostream& out) const;
+
+	/// @brief Checks if a record can be added to the page
+	/// @param record - the record
+	/// @return true if there is a free slot and enough free space for the record and false otherwise
+	bool canAdd(const Record& record) const;
+
+	/// @brief Checks if a record can be added with insertRecord
+	/// @param record - the record
+	/// @return true if the record fits in an empty slot or in a new one and false otherwise
+	bool canInsert(const Record& record) const;
+
+	/// @brief Gets the biggest record (in encoded form) that can be added with insertRecord,
+	/// counting the space of the removed records
+	/// @return the size in bytes
+	size_t availableSpace() const;
+
+	/// @brief Checks if the page has a slot of a removed record
+	/// @return true if a slot is empty and false otherwise
+	inline bool hasEmptySlot() const { return header.liveRecords < header.slotsCount; }
+
+	/// @brief Checks if no more records can be added to the page
+	/// @return true if the page has the max number of records or no space for another slot and false otherwise
+	bool isFull() const;
+
+	/// @brief Checks if the page has no slots
+	/// @return true if the page is empty
+	inline bool isEmpty() const { return header.slotsCount == 0; }
+
+	/// @brief Gets the ammount of slots in the page (counting the empty ones)
+	/// @return the size of the slot directory
+	inline size_t size() const { return header.slotsCount; }
+
+	/// @brief Gets the size of the page image
+	/// @return the size in bytes
+	inline size_t getPageSize() const { return header.pageSize; }
+
+	/// @brief Checks if the page knows the types of its columns
+	/// @return true if the records are stored without type tags and false otherwise
+	inline bool isTyped() const { return !types.empty(); }
+
+	/// @brief Gets the biggest record (in encoded form) that fits in an empty page
+	/// @param pageSize - the size of the page
+	/// @param columns - the number of column types saved in the page
+	/// @return the size in bytes
+	static size_t maxRecordSize(size_t pageSize, size_t columns = 0) { return pageSize - sizeof(Header) - columns - sizeof(Slot); }
+
+private:
+	/// @brief Converts a page image saved in version 1 (records with type names) to the current version
+	/// @param in - the file that the old page image will be read from
+	/// @return the converted page
+	static Page fromVersion1(std::ifstream& in);
+
+	/// @brief Gets the position of the slot directory in the page image
+	/// @return the offset in bytes
+	inline size_t slotsStart() const { return sizeof(Header) + header.typesCount; }
+
+	/// @brief Gets the free space between the slot directory and the records
+	/// @return the free space in bytes
+	size_t freeSpace() const;
+
+	/// @brief Moves the records to the end of the page image, so the space of the removed records is between them
+	/// and the slot directory. The slots of the records keep their indexes.
+	void compact();
+
+	Slot readSlot(size_t index) const;
+	void writeSlot(size_t index, const Slot& slot);
+
+private:
+	Header header;
+	std::vector<char> image;
+	std::vector<DataType> types;
+};
+
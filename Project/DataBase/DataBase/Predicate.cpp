@@ -0,0 +1,160 @@
+#include "Predicate.h"
+
+Predicate::Op Predicate::toOp(const string& oper)
+{
+	if (oper == "<")
+		return Op::Less;
+	else if (oper == "<=")
+		return Op::LessEqual;
+	else if (oper == ">")
+		return Op::Greater;
+	else if (oper == ">=")
+		return Op::GreaterEqual;
+	else if (oper == "==")
+		return Op::Equal;
+	else if (oper == "!=")
+		return Op::NotEqual;
+
+	throw std::invalid_argument("Invalid operation given!");
+}
+
+void Predicate::pushComparison(size_t colInd, Op op, const Data& value)
+{
+	operands.push_back(nodes.size());
+	nodes.push_back({ op, colInd, value, 0, 0 });
+}
+
+void Predicate::pushLogical(Op op)
+{
+	Node node = { op, 0, Data(), 0, 0 };
+
+	if (op == Op::Not)
+	{
+		if (operands.empty())
+			throw std::exception("Not enough arguments for unary expression!");
+
+		node.left = operands.back();
+		operands.pop_back();
+	}
+	else
+	{
+		if (operands.size() < 2)
+			throw std::exception("Not enough arguments for binary expression!");
+
+		node.right = operands.back();
+		operands.pop_back();
+		node.left = operands.back();
+		operands.pop_back();
+	}
+
+	operands.push_back(nodes.size());
+	nodes.push_back(node);
+}
+
+bool Predicate::evaluate(size_t ind, const Record& record) const
+{
+	const Node& node = nodes[ind];
+
+	switch (node.op)
+	{
+	case Op::And:
+		return evaluate(node.left, record) && evaluate(node.right, record);
+	case Op::Or:
+		return evaluate(node.left, record) || evaluate(node.right, record);
+	case Op::Not:
+		return !evaluate(node.left, record);
+	default:
+		break;
+	}
+
+	int cmp = record.getColData(node.colInd).compare(node.value);
+
+	switch (node.op)
+	{
+	case Op::Less:
+		return cmp < 0;
+	case Op::LessEqual:
+		return cmp <= 0;
+	case Op::Greater:
+		return cmp > 0;
+	case Op::GreaterEqual:
+		return cmp >= 0;
+	case Op::Equal:
+		return cmp == 0;
+	case Op::NotEqual:
+		return cmp != 0;
+	default:
+		return false;
+	}
+}
+
+bool Predicate::mayMatch(const ZoneMap& zone) const
+{
+	if (zone.isEmpty())
+		return false;
+
+	bool mayBeFalse;
+	return nodes.empty() || evaluateRange(nodes.size() - 1, zone, mayBeFalse);
+}
+
+bool Predicate::evaluateRange(size_t ind, const ZoneMap& zone, bool& mayBeFalse) const
+{
+	const Node& node = nodes[ind];
+	bool leftFalse, rightFalse;
+
+	switch (node.op)
+	{
+	case Op::And:
+	{
+		bool left = evaluateRange(node.left, zone, leftFalse);
+		bool right = evaluateRange(node.right, zone, rightFalse);
+		mayBeFalse = leftFalse || rightFalse;
+		return left && right;
+	}
+	case Op::Or:
+	{
+		bool left = evaluateRange(node.left, zone, leftFalse);
+		bool right = evaluateRange(node.right, zone, rightFalse);
+		mayBeFalse = leftFalse && rightFalse;
+		return left || right;
+	}
+	case Op::Not:
+	{
+		bool mayBeTrue = evaluateRange(node.left, zone, leftFalse);
+		mayBeFalse = mayBeTrue;
+		return leftFalse;
+	}
+	default:
+		break;
+	}
+
+	// the values of the column in the page are between min and max
+	int cmpMin = zone.getMin(node.colInd).compare(node.value);
+	int cmpMax = zone.getMax(node.colInd).compare(node.value);
+	bool allEqual = cmpMin == 0 && cmpMax == 0;
+
+	switch (node.op)
+	{
+	case Op::Less:
+		mayBeFalse = cmpMax >= 0;
+		return cmpMin < 0;
+	case Op::LessEqual:
+		mayBeFalse = cmpMax > 0;
+		return cmpMin <= 0;
+	case Op::Greater:
+		mayBeFalse = cmpMin <= 0;
+		return cmpMax > 0;
+	case Op::GreaterEqual:
+		mayBeFalse = cmpMin < 0;
+		return cmpMax >= 0;
+	case Op::Equal:
+		mayBeFalse = !allEqual;
+		return cmpMin <= 0 && cmpMax >= 0 && zone.getFilter(node.colInd).mayContain(node.value);
+	case Op::NotEqual:
+		mayBeFalse = cmpMin <= 0 && cmpMax >= 0 && zone.getFilter(node.colInd).mayContain(node.value);
+		return !allEqual;
+	default:
+		mayBeFalse = true;
+		return true;
+	}
+}
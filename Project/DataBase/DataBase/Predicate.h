@@ -0,0 +1,94 @@
+#pragma once
+#include "Record.h"
+#include "ZoneMap.h"
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/// @brief A WHERE expression compiled once per statement. The columns are resolved to their indexes
+/// and the values are converted to the types of the columns beforehand, so checking a row doesn't parse
+/// or allocate anything. The expression is a tree kept in a vector, the root is the last node.
+
+class Predicate
+{
+public:
+	/// @brief The operation of a node of the expression
+	enum class Op : uint8_t
+	{
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		And,
+		Or,
+		Not
+	};
+
+	/// @brief Creates an empty predicate which every row satisfies
+	Predicate() {}
+
+	/// @brief Converts a comparison operator to an operation
+	/// @param oper - the operator ("<", "<=", ">", ">=", "==" or "!=")
+	/// @return the operation
+	static Op toOp(const string& oper);
+
+	/// @brief Adds a comparison of a column with a value (the nodes are added in postfix order)
+	/// @param colInd - the index of the column
+	/// @param op - the comparison operation
+	/// @param value - the value, already converted to the type of the column
+	void pushComparison(size_t colInd, Op op, const Data& value);
+
+	/// @brief Adds a logical operation of the last one (NOT) or two (AND, OR) added expressions
+	/// @param op - the logical operation
+	void pushLogical(Op op);
+
+	/// @brief Checks if the added nodes form exactly one expression
+	/// @return true if the predicate is complete and false otherwise
+	inline bool isComplete() const { return operands.size() == 1; }
+
+	/// @brief Checks if the predicate has no nodes
+	/// @return true if every row satisfies the predicate and false otherwise
+	inline bool isEmpty() const { return nodes.empty(); }
+
+	/// @brief Checks if a row satisfies the predicate
+	/// @param record - the row
+	/// @return true if it satisfies it and false otherwise
+	bool matches(const Record& record) const { return nodes.empty() || evaluate(nodes.size() - 1, record); }
+
+	/// @brief Checks if some row of a page may satisfy the predicate, judging only by the summary of the page
+	/// @param zone - the summary of the page
+	/// @return false if no row of the page satisfies the predicate and true if some may
+	bool mayMatch(const ZoneMap& zone) const;
+
+private:
+	/// @brief A node of the expression - a comparison or a logical operation
+	struct Node
+	{
+		Op op;
+		size_t colInd; // the column of a comparison
+		Data value; // the value of a comparison
+		size_t left; // the index of the first operand of a logical operation
+		size_t right; // the index of the second operand of AND and OR
+	};
+
+	/// @brief Evaluates a node for a given row
+	/// @param ind - the index of the node
+	/// @param record - the row
+	/// @return the result of the node
+	bool evaluate(size_t ind, const Record& record) const;
+
+	/// @brief Evaluates a node for the ranges of the columns of a page
+	/// @param ind - the index of the node
+	/// @param zone - the summary of the page
+	/// @param mayBeFalse - set to true if some row of the page may not satisfy the node (needed for NOT)
+	/// @return true if some row of the page may satisfy the node
+	bool evaluateRange(size_t ind, const ZoneMap& zone, bool& mayBeFalse) const;
+
+private:
+	vector<Node> nodes;
+	vector<size_t> operands; // the roots of the expressions that aren't operands of a logical operation yet
+};
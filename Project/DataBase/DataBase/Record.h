@@ -1,71 +1,132 @@
-#pragma once
-#include <vector>
-#include "Data.h"
-
-/// @brief A class representing one row in a table
-
-class Record
-{
-public:
-	Record() : bytes(0) {}
-
-	/// @brief Deserializing constructor
-	/// @param in - the file that the object will be read from
-	Record(std::ifstream& in)
-	{
-		in.read((char*)&bytes, sizeof(bytes));
-
-		size_t len;
-		in.read((char*)&len, sizeof(len));
-
-		for (size_t i = 0; i < len; i++)
-			columns.push_back(Data(in));
-	}
-
-	/// @brief Gets the element of the table at a given index of the columns vector
-	/// @param index - the index of the column
-	/// @return the Data object that is a at the index of the column in a table
-	Data getColData(size_t index) const
-	{
-		if (index >= 0 && index < columns.size())
-			return columns[index];
-		throw std::invalid_argument("Column index out of bounds");
-	}
-
-	/// @brief Adds Data object in the columns vector
-	/// @param data - the element that will be added
-	inline void addColumn(Data data) { columns.push_back(data); bytes += data.getBytes(); }
-
-	/// @brief Gets the ammount of the columns
-	/// @return the size of the columns vector
-	inline size_t size() const { return columns.size(); }
-
-	/// @brief Saves the record to a file in a binary format
-	/// @param out - the file
-	void serialize(std::ofstream& out) const
-	{
-		out.write((const char*)&bytes, sizeof(bytes));
-
-		size_t len = columns.size();
-		out.write((const char*)&len, sizeof(len));
-
-		for (size_t i = 0; i < len; i++)
-			columns[i].serialize(out);
-	}
-
-	/// @brief Clears the record (used to get the right indexe from the RecordPtr)
-	inline void clear() { columns.clear(); bytes = 0; };
-
-	/// @brief Check if the record is empty
-	/// @return true if the size (bytes) of the record are 0 and false otherwise
-	inline bool isEmpty() { return bytes == 0; }
-
-	/// @brief Gets the size of the record
-	/// @return the size of the recordin bytes
-	unsigned int getBytes() const { return bytes; }
-
-private:
-	unsigned int bytes;
-	std::vector<Data> columns;
-};
-
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "Data.h"
+
+/// @brief A class representing one row in a table
+
+class Record
+{
+public:
+	Record() : bytes(0) {}
+
+	/// @brief Reads a record saved in the old format (a stream of records in a page file)
+	/// @param in - the file that the object will be read from
+	/// @return the read record
+	static Record fromLegacy(std::ifstream& in)
+	{
+		Record res;
+		in.read((char*)&res.bytes, sizeof(res.bytes));
+
+		size_t len;
+		in.read((char*)&len, sizeof(len));
+
+		for (size_t i = 0; i < len; i++)
+			res.columns.push_back(Data::fromLegacy(in));
+
+		return res;
+	}
+
+	/// @brief Constructor that reads the record from its encoded form in a page
+	/// @param buffer - the beginning of the encoded record
+	/// @param length - the length of the encoded record
+	/// @param types - the types of the columns if the values were written without tags and empty otherwise
+	Record(const char* buffer, size_t length, const std::vector<DataType>& types = {})
+		: bytes(0)
+	{
+		size_t offset = 0;
+		if (!types.empty())
+		{
+			columns.reserve(types.size());
+			for (size_t i = 0; i < types.size() && offset < length; i++)
+				addColumn(Data(buffer, offset, types[i]));
+			return;
+		}
+
+		uint16_t len;
+		std::memcpy(&len, buffer, sizeof(len));
+
+		offset = sizeof(len);
+		columns.reserve(len);
+		for (size_t i = 0; i < len && offset < length; i++)
+			addColumn(Data(buffer, offset));
+	}
+
+	/// @brief Gets the element of the table at a given index of the columns vector
+	/// @param index - the index of the column
+	/// @return the Data object that is a at the index of the column in a table
+	const Data& getColData(size_t index) const
+	{
+		if (index >= 0 && index < columns.size())
+			return columns[index];
+		throw std::invalid_argument("Column index out of bounds");
+	}
+
+	/// @brief Adds Data object in the columns vector
+	/// @param data - the element that will be added
+	inline void addColumn(Data data) { columns.push_back(data); bytes += data.getBytes(); }
+
+	/// @brief Gets the ammount of the columns
+	/// @return the size of the columns vector
+	inline size_t size() const { return columns.size(); }
+
+	/// @brief Gets the size of the record in the format it is stored in a page
+	/// @param tagged - false if the page knows the types of the columns, so the column count and the type tags are left out
+	/// @return the size in bytes
+	size_t encodedSize(bool tagged = true) const
+	{
+		size_t size = tagged ? sizeof(uint16_t) : 0;
+		for (size_t i = 0; i < columns.size(); i++)
+			size += columns[i].encodedSize(tagged);
+
+		return size;
+	}
+
+	/// @brief Writes the record in the format it is stored in a page
+	/// @param buffer - the place to write to (at least encodedSize(tagged) bytes)
+	/// @param tagged - false if the page knows the types of the columns, so the column count and the type tags are left out
+	void encode(char* buffer, bool tagged = true) const
+	{
+		size_t offset = 0;
+		if (tagged)
+		{
+			uint16_t len = columns.size();
+			std::memcpy(buffer, &len, sizeof(len));
+			offset = sizeof(len);
+		}
+
+		for (size_t i = 0; i < columns.size(); i++)
+			columns[i].encode(buffer, offset, tagged);
+	}
+
+	/// @brief Checks if the types of the columns are the given ones
+	/// @param types - the types
+	/// @return true if the record has the same number of columns and of the same types and false otherwise
+	bool matches(const std::vector<DataType>& types) const
+	{
+		if (columns.size() != types.size())
+			return false;
+		for (size_t i = 0; i < columns.size(); i++)
+			if (columns[i].getType() != types[i])
+				return false;
+
+		return true;
+	}
+
+	/// @brief Clears the record (used to get the right indexe from the RecordPtr)
+	inline void clear() { columns.clear(); bytes = 0; };
+
+	/// @brief Check if the record is empty
+	/// @return true if the size (bytes) of the record are 0 and false otherwise
+	inline bool isEmpty() { return bytes == 0; }
+
+	/// @brief Gets the size of the record
+	/// @return the size of the recordin bytes
+	unsigned int getBytes() const { return bytes; }
+
+private:
+	unsigned int bytes;
+	std::vector<Data> columns;
+};
+
@@ -0,0 +1,244 @@
+#include "RowBitmap.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static const size_t WORD_BITS = 64;
+
+/// @brief Counts the set bits of a word
+static inline size_t popCount(uint64_t word)
+{
+#ifdef _MSC_VER
+	return (size_t)__popcnt64(word);
+#else
+	return (size_t)__builtin_popcountll(word);
+#endif
+}
+
+/// @brief Gives the index of the lowest set bit of a word (the word isn't 0)
+static inline size_t lowestBit(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long ind;
+	_BitScanForward64(&ind, word);
+	return ind;
+#else
+	return (size_t)__builtin_ctzll(word);
+#endif
+}
+
+RowBitmap::RowBitmap(vector<RecordPtr> recordPtrs)
+{
+	if (!std::is_sorted(recordPtrs.begin(), recordPtrs.end()))
+		std::sort(recordPtrs.begin(), recordPtrs.end());
+
+	// the rows are sorted, so every container is created at the end
+	for (size_t i = 0; i < recordPtrs.size(); i++)
+	{
+		size_t pageNum = recordPtrs[i].pageNumber();
+		if (containers.empty() || containers.back().pageNumber != pageNum)
+			containers.push_back({ pageNum, {} });
+
+		vector<uint64_t>& words = containers.back().words;
+		size_t row = recordPtrs[i].rowNumber();
+		if (words.size() <= row / WORD_BITS)
+			words.resize(row / WORD_BITS + 1, 0);
+
+		words[row / WORD_BITS] |= uint64_t(1) << (row % WORD_BITS);
+	}
+}
+
+void RowBitmap::add(const RecordPtr& recordPtr)
+{
+	size_t pageNum = recordPtr.pageNumber();
+	size_t ind = findContainer(pageNum);
+	if (ind == containers.size() || containers[ind].pageNumber != pageNum)
+		containers.insert(containers.begin() + ind, { pageNum, {} });
+
+	vector<uint64_t>& words = containers[ind].words;
+	size_t row = recordPtr.rowNumber();
+	if (words.size() <= row / WORD_BITS)
+		words.resize(row / WORD_BITS + 1, 0);
+
+	words[row / WORD_BITS] |= uint64_t(1) << (row % WORD_BITS);
+}
+
+void RowBitmap::remove(const RecordPtr& recordPtr)
+{
+	size_t ind = findContainer(recordPtr.pageNumber());
+	if (ind == containers.size() || containers[ind].pageNumber != recordPtr.pageNumber())
+		return;
+
+	vector<uint64_t>& words = containers[ind].words;
+	size_t row = recordPtr.rowNumber();
+	if (row / WORD_BITS < words.size())
+		words[row / WORD_BITS] &= ~(uint64_t(1) << (row % WORD_BITS));
+
+	if (isEmpty(containers[ind]))
+		containers.erase(containers.begin() + ind);
+}
+
+bool RowBitmap::contains(const RecordPtr& recordPtr) const
+{
+	size_t ind = findContainer(recordPtr.pageNumber());
+	if (ind == containers.size() || containers[ind].pageNumber != recordPtr.pageNumber())
+		return false;
+
+	const vector<uint64_t>& words = containers[ind].words;
+	size_t row = recordPtr.rowNumber();
+
+	return row / WORD_BITS < words.size() && (words[row / WORD_BITS] >> (row % WORD_BITS) & 1);
+}
+
+size_t RowBitmap::size() const
+{
+	size_t count = 0;
+	for (const Container& container : containers)
+	{
+		for (uint64_t word : container.words)
+			count += popCount(word);
+	}
+
+	return count;
+}
+
+vector<RecordPtr> RowBitmap::toRecordPtrs() const
+{
+	vector<RecordPtr> result;
+	for (const Container& container : containers)
+	{
+		for (size_t i = 0; i < container.words.size(); i++)
+		{
+			// every set bit is taken out of the word, starting from the lowest one
+			for (uint64_t word = container.words[i]; word != 0; word &= word - 1)
+				result.push_back(RecordPtr((int)container.pageNumber, (int)(i * WORD_BITS + lowestBit(word))));
+		}
+	}
+
+	return result;
+}
+
+RowBitmap& RowBitmap::operator&=(const RowBitmap& other)
+{
+	vector<Container> result;
+	size_t j = 0;
+
+	for (size_t i = 0; i < containers.size(); i++)
+	{
+		while (j < other.containers.size() && other.containers[j].pageNumber < containers[i].pageNumber)
+			j++;
+
+		if (j == other.containers.size())
+			break;
+
+		if (other.containers[j].pageNumber != containers[i].pageNumber)
+			continue;
+
+		Container& container = containers[i];
+		const vector<uint64_t>& otherWords = other.containers[j].words;
+		if (container.words.size() > otherWords.size())
+			container.words.resize(otherWords.size());
+
+		for (size_t k = 0; k < container.words.size(); k++)
+			container.words[k] &= otherWords[k];
+
+		if (!isEmpty(container))
+			result.push_back(std::move(container));
+	}
+
+	containers = std::move(result);
+	return *this;
+}
+
+RowBitmap& RowBitmap::operator|=(const RowBitmap& other)
+{
+	vector<Container> result;
+	result.reserve(containers.size() + other.containers.size());
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < containers.size() || j < other.containers.size())
+	{
+		if (j == other.containers.size() || (i < containers.size() && containers[i].pageNumber < other.containers[j].pageNumber))
+			result.push_back(std::move(containers[i++]));
+		else if (i == containers.size() || other.containers[j].pageNumber < containers[i].pageNumber)
+			result.push_back(other.containers[j++]);
+		else
+		{
+			Container& container = containers[i++];
+			const vector<uint64_t>& otherWords = other.containers[j++].words;
+			if (container.words.size() < otherWords.size())
+				container.words.resize(otherWords.size(), 0);
+
+			for (size_t k = 0; k < otherWords.size(); k++)
+				container.words[k] |= otherWords[k];
+
+			result.push_back(std::move(container));
+		}
+	}
+
+	containers = std::move(result);
+	return *this;
+}
+
+RowBitmap& RowBitmap::operator-=(const RowBitmap& other)
+{
+	vector<Container> result;
+	result.reserve(containers.size());
+	size_t j = 0;
+
+	for (size_t i = 0; i < containers.size(); i++)
+	{
+		while (j < other.containers.size() && other.containers[j].pageNumber < containers[i].pageNumber)
+			j++;
+
+		Container& container = containers[i];
+		if (j < other.containers.size() && other.containers[j].pageNumber == container.pageNumber)
+		{
+			const vector<uint64_t>& otherWords = other.containers[j].words;
+			for (size_t k = 0; k < container.words.size() && k < otherWords.size(); k++)
+				container.words[k] &= ~otherWords[k];
+
+			if (isEmpty(container))
+				continue;
+		}
+
+		result.push_back(std::move(container));
+	}
+
+	containers = std::move(result);
+	return *this;
+}
+
+size_t RowBitmap::findContainer(size_t pageNumber) const
+{
+	// new rows go to the last page, so it is checked before searching
+	if (containers.empty() || containers.back().pageNumber < pageNumber)
+		return containers.size();
+
+	size_t left = 0;
+	size_t right = containers.size();
+	while (left < right)
+	{
+		size_t mid = left + (right - left) / 2;
+		if (containers[mid].pageNumber < pageNumber)
+			left = mid + 1;
+		else
+			right = mid;
+	}
+
+	return left;
+}
+
+bool RowBitmap::isEmpty(const Container& container)
+{
+	for (uint64_t word : container.words)
+	{
+		if (word != 0)
+			return false;
+	}
+
+	return true;
+}
+
@@ -0,0 +1,80 @@
+#pragma once
+#include "RecordPtr.h"
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+/// @brief A compressed set of rows of a table. The rows are grouped by the page they are in - every page
+/// that has rows in the set has a container with one bit per row of the page, and the containers are kept
+/// sorted by page number (like the containers of a roaring bitmap). Union, intersection and difference
+/// go through the containers of both sets at once and combine them word by word, and the rows come out
+/// in the order they are stored, so they can be fetched one page at a time.
+
+class RowBitmap
+{
+public:
+	/// @brief Creates an empty set
+	RowBitmap() {}
+
+	/// @brief Creates a set of the given rows
+	/// @param recordPtrs - the rows in any order
+	RowBitmap(vector<RecordPtr> recordPtrs);
+
+	/// @brief Adds a row to the set
+	/// @param recordPtr - the row
+	void add(const RecordPtr& recordPtr);
+
+	/// @brief Removes a row from the set (if it is in the set)
+	/// @param recordPtr - the row
+	void remove(const RecordPtr& recordPtr);
+
+	/// @brief Checks if a row is in the set
+	/// @param recordPtr - the row
+	/// @return true if it is in the set and false otherwise
+	bool contains(const RecordPtr& recordPtr) const;
+
+	/// @brief Gets the amount of rows in the set
+	/// @return the number of rows
+	size_t size() const;
+
+	inline bool isEmpty() const { return containers.empty(); }
+
+	/// @brief Gives the rows of the set ordered by page and row
+	/// @return the rows
+	vector<RecordPtr> toRecordPtrs() const;
+
+	/// @brief Keeps only the rows that are in both sets
+	/// @param other - the other set
+	RowBitmap& operator&=(const RowBitmap& other);
+
+	/// @brief Adds the rows of another set
+	/// @param other - the other set
+	RowBitmap& operator|=(const RowBitmap& other);
+
+	/// @brief Removes the rows of another set (AND NOT)
+	/// @param other - the other set
+	RowBitmap& operator-=(const RowBitmap& other);
+
+private:
+	/// @brief The rows of one page - bit i of the words is set if row i is in the set
+	struct Container
+	{
+		size_t pageNumber;
+		vector<uint64_t> words;
+	};
+
+	/// @brief Finds the container of a page
+	/// @param pageNumber - the number of the page
+	/// @return the index of the container of the page or the index it would be inserted at
+	size_t findContainer(size_t pageNumber) const;
+
+	/// @brief Checks if a container has no rows
+	/// @param container - the container
+	/// @return true if no bit is set and false otherwise
+	static bool isEmpty(const Container& container);
+
+private:
+	vector<Container> containers; // sorted by page number, none of them is empty
+};
+
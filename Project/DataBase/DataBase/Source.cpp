@@ -1,9 +1,9 @@
-﻿#include <iostream>
-#include "System.h"
-
-int main()
-{
-	System::i().run();
-
-	return 0;
+﻿#include <iostream>
+#include "System.h"
+
+int main()
+{
+	System::i().run();
+
+	return 0;
 }
\ No newline at end of file
@@ -1,58 +1,56 @@
-#pragma once
-#include "Type.h"
-
-/// @brief class deriving Type with string value
-
-class String : public Type
-{
-public:
-	String(const std::string& value = "");
-	String& operator=(const std::string& value);
-
-	/// @brief Creates a new String object
-	/// @return new String
-	virtual Type* clone() const override;
-
-	/// @brief Saves object to file in binary format
-	/// @param out - the file
-	virtual void serialize(std::ofstream& out) const override;
-
-	/// @brief Reads the object from a file in binary format
-	/// @param in - the file
-	virtual void deserialize(std::ifstream& in) override;
-
-	virtual bool operator<(const Type& other) const override;
-	virtual bool operator<=(const Type& other) const override;
-	virtual bool operator>(const Type& other) const override;
-	virtual bool operator>=(const Type& other) const override;
-	virtual bool operator==(const Type& other) const override;
-	virtual bool operator!=(const Type& other) const override;
-
-	/// @brief Gives us the value of the object
-	/// @return the value
-	virtual std::string toString() const override;
-
-	/// @brief Gives us the value of the object converted to int
-	/// @return the value
-	virtual int toInteger() const override;
-
-	/// @brief Gives us the value of the object converted to double
-	/// @return the value
-	virtual double toDouble() const override;
-
-	/// @brief Gives us the size of the object in bytes
-	/// @return the size of the value
-	virtual unsigned int getBytes() const override { return sizeof(value); }
-
-private:
-
-	inline bool isUpperCase(char ch) const { return ch >= 'A' && ch <= 'Z'; }
-
-	/// @brief Turns all upper case letters from str to lower case
-	/// @param str - the string to be transformed
-	/// @return the transformed string
-	std::string toLower(const std::string& str) const;
-
-	std::string value;
-};
-
+#pragma once
+#include <string>
+
+/// @brief Value class with string value, compared case-insensitively
+
+class String
+{
+public:
+	String(const std::string& value = "");
+	String& operator=(const std::string& value);
+
+	bool operator<(const String& other) const { return compare(other) < 0; }
+	bool operator<=(const String& other) const { return compare(other) <= 0; }
+	bool operator>(const String& other) const { return compare(other) > 0; }
+	bool operator>=(const String& other) const { return compare(other) >= 0; }
+	bool operator==(const String& other) const { return compare(other) == 0; }
+	bool operator!=(const String& other) const { return compare(other) != 0; }
+
+	/// @brief Gives us the value of the object
+	/// @return the value
+	std::string toString() const { return value; }
+
+	/// @brief Gives us the value of the object converted to int
+	/// @return the value or 0 if the string is empty
+	int toInteger() const;
+
+	/// @brief Gives us the value of the object converted to double
+	/// @return the value or 0 if the string is empty
+	double toDouble() const;
+
+	/// @brief Gives us the size of the object in bytes
+	/// @return the size of the value
+	unsigned int getBytes() const { return sizeof(value); }
+
+	/// @brief Compares two strings ignoring the case of the letters without copying them
+	/// @param left - the characters of the first string
+	/// @param leftLen - the length of the first string
+	/// @param right - the characters of the second string
+	/// @param rightLen - the length of the second string
+	/// @return negative if left is smaller, 0 if they are equal and positive if left is bigger
+	static int compare(const char* left, size_t leftLen, const char* right, size_t rightLen);
+
+	/// @brief Gives the lowercase letter of an uppercase one, the way the strings are compared
+	/// @param ch - the character
+	/// @return the lowercase letter or the same character if it isn't an uppercase letter
+	static inline char toLower(char ch) { return ch >= 'A' && ch <= 'Z' ? ch + ('a' - 'A') : ch; }
+
+private:
+	int compare(const String& other) const
+	{
+		return compare(value.data(), value.size(), other.value.data(), other.value.size());
+	}
+
+	std::string value;
+};
+
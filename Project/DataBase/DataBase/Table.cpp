@@ -1,1448 +1,1806 @@
-#include "Table.h"
-
-Table::Table()
-	: name("")
-	, currPageNumber(0)
-	, bytes(0)
-{}
-
-Table::Table(const string& header, const string& name, const string& firstIndexedCol)
-	: name(name)
-	, currPageNumber(0)
-	, bytes(0)
-{
-	setCollections(header);
-	if (!firstIndexedCol.empty())
-
-		indexedCols.push_back(firstIndexedCol);
-	else
-		indexedCols.push_back(colNames[0]);
-	indexedColsRecordsHT.insert({ indexedCols[0], BPlusTree() });
-	createPage();
-	serialize();
-}
-
-Table::Table(std::ifstream& in)
-{
-	size_t len;
-	in.read((char*)&len, sizeof(len));
-	name.resize(len);
-	in.read((char*)&name[0], len);
-
-	in.read((char*)&currPageNumber, sizeof(currPageNumber));
-	in.read((char*)&bytes, sizeof(bytes));
-
-	in.read((char*)&len, sizeof(len));
-	colNames.reserve(len);
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size;
-		in.read((char*)&size, sizeof(size));
-
-		string colName;
-		colName.resize(size);
-		in.read((char*)&colName[0], size);
-		colNames.push_back(colName);
-	}
-
-	in.read((char*)&len, sizeof(len));
-	colTypes.reserve(len);
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size;
-		in.read((char*)&size, sizeof(size));
-
-		string colType;
-		colType.resize(size);
-		in.read((char*)&colType[0], size);
-		colTypes.push_back(colType);
-	}
-
-	in.read((char*)&len, sizeof(len));
-	indexedCols.reserve(len);
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size;
-		in.read((char*)&size, sizeof(size));
-
-		string colName;
-		colName.resize(size);
-		in.read((char*)&colName[0], size);
-		indexedCols.push_back(colName);
-	}
-
-	in.read((char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size;
-		in.read((char*)&size, sizeof(size));
-		string first;
-		first.resize(size);
-		in.read((char*)&first[0], size);
-
-		size_t second;
-		in.read((char*)&second, sizeof(second));
-
-		colNameIndexHT.insert({ first,second });
-	}
-
-	in.read((char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size;
-		in.read((char*)&size, sizeof(size));
-		string colName;
-		colName.resize(size);
-		in.read((char*)&colName[0], size);
-
-		BPlusTree column(in);
-		indexedColsRecordsHT[colName] = column;
-	}
-}
-
-void Table::insert(const vector<string>& recordStr)
-{
-	for (size_t i = 0; i < recordStr.size(); i++)
-	{
-		Record record = toRecord(recordStr[i]);
-
-		ifstream in(name + "_page" + std::to_string(currPageNumber) + ".bin", std::ios::binary);
-		if (!in)
-			throw std::exception("Couldn't open page for reading!");
-
-		Page page(in);
-		in.close();
-
-		if (page.isFull())
-			page = createPage();
-
-		page.addRecord(record);
-		bytes += record.getBytes();
-
-		ofstream out(name + "_page" + std::to_string(currPageNumber) + ".bin", std::ios::binary);
-		if (!out)
-			throw std::exception("Couldn't open page for writing!");
-
-		page.serialize(out);
-
-		out.close();
-
-		for (size_t i = 0; i < indexedCols.size(); i++)
-		{
-			indexedColsRecordsHT[indexedCols[i]]
-				.insert({ record.getColData(colNameIndexHT[indexedCols[i]]), RecordPtr(currPageNumber, page.size() - 1) });
-		}
-	}
-}
-
-vector<string> Table::select(const string& expression, const string& orderByWhat, bool distinct, const string& toPrint) const
-{
-	vector<string> result;
-
-	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
-		return result;
-
-	vector<string> expressionArr = parseExpression(expression);
-	vector<Record> selected;
-	vector<RecordPtr> recordPtrs;
-
-	if (containsOnlyIndexedCols(expressionArr))
-	{
-		recordPtrs = getIntervals(expressionArr);
-		if (recordPtrs.empty()) return result;
-		transformToRecords(recordPtrs, selected);
-	}
-	else
-	{
-		recordPtrs = indexedColsRecordsHT.at(indexedCols[0])
-			.getElementsInRange(indexedColsRecordsHT.at(indexedCols[0]).min(), indexedColsRecordsHT.at(indexedCols[0]).max());
-		if (recordPtrs.empty()) return result;
-		checkCondAndTransformToRecords(recordPtrs, selected, expressionArr);
-	}
-
-	if (orderByWhat != "")
-		orderBy(selected, orderByWhat);
-
-	if (distinct)
-		makeDistinct(toPrint, result, selected);
-	else
-		notDistinct(toPrint, result, selected);
-
-	return result;
-}
-
-void Table::remove(const string& expression)
-{
-	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
-		return;
-
-	vector<string> expressionArr = parseExpression(expression);
-
-	vector<RecordPtr> recordPtrs = indexedColsRecordsHT.at(indexedCols[0])
-		.getElementsInRange(indexedColsRecordsHT.at(indexedCols[0]).min(), indexedColsRecordsHT.at(indexedCols[0]).max());
-
-	if (!areSorted(recordPtrs))
-		heapSortRecordPtrs(recordPtrs);
-
-	for (size_t i = 0; i < recordPtrs.size(); i++)
-	{
-		size_t num = recordPtrs[i].pageNumber();
-		ifstream in(name + "_page" + std::to_string(recordPtrs[i].pageNumber()) + ".bin", std::ios::binary);
-		size_t ind = i;
-		if (!in)
-			throw std::exception("Couldn't open page for reading!");
-
-		Page page(in);
-
-		if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-		{
-			while (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-			{
-				RecordPtr recPtr = recordPtrs[i];
-				Record record = page.getRecord(recordPtrs[i].rowNumber());
-				if (!record.isEmpty() && (expression.empty() || checkRecordCondition(record, expressionArr)))
-				{
-					for (size_t k = 0; k < indexedCols.size(); k++)
-					{
-						indexedColsRecordsHT[indexedCols[k]]
-							.remove({ record.getColData(colNameIndexHT[indexedCols[k]]), recPtr });
-					}
-					page.removeRecord(recordPtrs[i].rowNumber());
-					bytes -= record.getBytes();
-				}
-				i++;
-			}
-			if (i < recordPtrs.size() && recordPtrs[i].pageNumber() == num)
-			{
-				RecordPtr recPtr = recordPtrs[i];
-				Record record = page.getRecord(recordPtrs[i].rowNumber());
-				if (!record.isEmpty() && (expression.empty() || checkRecordCondition(record, expressionArr)))
-				{
-					for (size_t k = 0; k < indexedCols.size(); k++)
-					{
-						indexedColsRecordsHT[indexedCols[k]]
-							.remove({ record.getColData(colNameIndexHT[indexedCols[k]]), recPtr });
-					}
-					page.removeRecord(recordPtrs[i].rowNumber());
-					bytes -= record.getBytes();
-				}
-			}
-		}
-		else if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() != recordPtrs[i + 1].pageNumber())
-		{
-			RecordPtr recPtr = recordPtrs[i];
-			Record record = page.getRecord(recordPtrs[i].rowNumber());
-			if (!record.isEmpty() && (expression.empty() || checkRecordCondition(record, expressionArr)))
-			{
-				for (size_t k = 0; k < indexedCols.size(); k++)
-				{
-					indexedColsRecordsHT[indexedCols[k]]
-						.remove({ record.getColData(colNameIndexHT[indexedCols[k]]), recPtr });
-				}
-				bytes -= record.getBytes();
-				page.removeRecord(recordPtrs[i].rowNumber());
-			}
-		}
-		else if (i == recordPtrs.size() - 1)
-		{
-			RecordPtr recPtr = recordPtrs[i];
-			Record record = page.getRecord(recordPtrs[i].rowNumber());
-			if (!record.isEmpty() && (expression.empty() || checkRecordCondition(record, expressionArr)))
-			{
-				for (size_t k = 0; k < indexedCols.size(); k++)
-				{
-					indexedColsRecordsHT[indexedCols[k]]
-						.remove({ record.getColData(colNameIndexHT[indexedCols[k]]), recPtr });
-				}
-				bytes -= record.getBytes();
-				page.removeRecord(recordPtrs[i].rowNumber());
-			}
-		}
-
-		in.close();
-
-		std::ofstream out(name + "_page" + std::to_string(recordPtrs[ind].pageNumber()) + ".bin", std::ios::binary);
-		if (!out)
-			throw std::exception("Couldn't open page for writing!");
-
-		page.serialize(out);
-
-		out.close();
-	}
-	//serialize();
-}
-
-void Table::createIndex(const string& indexCol)
-{
-	if (colNameIndexHT.find(indexCol) != colNameIndexHT.end())
-		throw std::invalid_argument("Column doesn't exist!");
-
-	if (indexedColsRecordsHT.find(indexCol) != indexedColsRecordsHT.end())
-		throw std::invalid_argument("This column already has an index!");
-
-	indexedCols.push_back(indexCol);
-
-	vector<RecordPtr> recordPtrs;
-	if (!indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
-		recordPtrs = indexedColsRecordsHT.at(indexedCols[0])
-		.getElementsInRange(indexedColsRecordsHT.at(indexedCols[0]).min(), indexedColsRecordsHT.at(indexedCols[0]).max());
-
-	vector<Record> records;
-	transformToRecords(recordPtrs, records);
-
-	for (size_t i = 0; i < records.size(); i++)
-	{
-		indexedColsRecordsHT[indexCol].insert({ records[i].getColData(colNameIndexHT.at(indexCol)), recordPtrs[i] });
-	}
-}
-
-void Table::serialize() const
-{
-	std::ofstream out(name + ".bin", std::ios::binary);
-
-	size_t len = name.length();
-	out.write((const char*)&len, sizeof(len));
-	out.write((const char*)&name[0], len);
-
-	out.write((const char*)&currPageNumber, sizeof(currPageNumber));
-	out.write((const char*)&bytes, sizeof(bytes));
-
-	len = colNames.size();
-	out.write((const char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size = colNames[i].length();
-		out.write((const char*)&size, sizeof(size));
-		out.write((const char*)&colNames[i][0], size);
-	}
-
-	len = colTypes.size();
-	out.write((const char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size = colTypes[i].length();
-		out.write((const char*)&size, sizeof(size));
-		out.write((const char*)&colTypes[i][0], size);
-	}
-
-	len = indexedCols.size();
-	out.write((const char*)&len, sizeof(len));
-	for (size_t i = 0; i < len; i++)
-	{
-		size_t size = indexedCols[i].length();
-		out.write((const char*)&size, sizeof(size));
-		out.write((const char*)&indexedCols[i][0], size);
-	}
-
-	len = colNameIndexHT.size();
-	out.write((const char*)&len, sizeof(len));
-	for (const pair<string, size_t>& p : colNameIndexHT)
-	{
-		size_t size = p.first.length();
-		out.write((const char*)&size, sizeof(size));
-		out.write((const char*)&p.first[0], size);
-
-		out.write((const char*)&p.second, sizeof(p.second));
-	}
-
-	len = indexedColsRecordsHT.size();
-	out.write((const char*)&len, sizeof(len));
-	for (const pair<string, BPlusTree>& p : indexedColsRecordsHT)
-	{
-		size_t size = p.first.length();
-		out.write((const char*)&size, sizeof(size));
-		out.write((const char*)&p.first[0], size);
-
-		p.second.serialize(out);
-	}
-
-	out.close();
-}
-
-string Table::getHeaderInfo() const
-{
-	string res;
-
-	res.push_back('(');
-
-	for (size_t i = 0; i < colNames.size(); i++)
-	{
-		res += colNames[i];
-		res.push_back(':');
-		res += colTypes[i];
-
-		for (size_t j = 0; j < indexedCols.size(); j++)
-		{
-			if (colNames[i] == indexedCols[j])
-			{
-				res += ", ";
-				res += "Indexed";
-			}
-		}
-
-		if (i != colNames.size() - 1) res += "; ";
-	}
-
-	res.push_back(')');
-
-	return res;
-}
-
-vector<string> Table::getColsNamesToPrint(const string& toPrint) const
-{
-	vector<string> result;
-
-	if (toPrint == "*")
-	{
-		return colNames;
-	}
-	else
-		result = parseColsToPrint(toPrint);
-
-	return result;
-}
-
-Page Table::createPage()
-{
-	currPageNumber++;
-	Page p;
-	std::ofstream out(name + "_page" + std::to_string(currPageNumber) + ".bin", std::ios::binary);
-	if (!out)
-		throw std::exception("Couldn't open page for writing!");
-	p.serialize(out);
-	out.close();
-	return p;
-}
-
-void Table::setCollections(const string& header)
-{
-	string currColName;
-	string currColType;
-
-	bool buildColName = true;
-	bool buildColType = false;
-
-	// header example: (ID:Int, Name:String, Value:Int)
-
-	size_t ind = 0;
-
-	for (size_t i = 1; i < header.size() - 1; i++)
-	{
-		if (header[i] == ' ')
-			continue;
-		else if (header[i] == ':' || header[i] == ',')
-		{
-			if (header[i] == ',')
-			{
-				colNames.push_back(currColName);
-				colTypes.push_back(currColType);
-				colNameIndexHT[currColName] = ind++;
-
-				currColName.clear();
-				currColType.clear();
-			}
-
-			buildColName = !buildColName;
-			buildColType = !buildColType;
-			continue;
-		}
-
-		if (buildColName)
-			currColName += header[i];
-		else if (buildColType)
-			currColType += header[i];
-	}
-
-	colNames.push_back(currColName);
-	colTypes.push_back(currColType);
-	colNameIndexHT[currColName] = ind++;
-}
-
-Record Table::toRecord(const string& str) const
-{
-	Record res;
-
-	size_t ind = 0;
-	string currData;
-	bool readingString = false;
-
-	// str example: (1, "Test", 10)
-
-	for (size_t i = 0; i < str.size(); i++)
-	{
-		if (str[i] == '\"')
-			readingString = !readingString;
-
-		if (readingString)
-		{
-			currData += str[i];
-			continue;
-		}
-
-		if (str[i] == '(' || str[i] == ' ')
-			continue;
-
-		if (str[i] == ',' || str[i] == ')')
-		{
-			if (isInteger(currData))
-			{
-				if (colTypes[ind] != "Int")
-					throw std::invalid_argument("Invalid row given!");
-				Data d(std::stoi(currData));
-				res.addColumn(d);
-			}
-			else if (isDouble(currData))
-			{
-				if (colTypes[ind] != "Double")
-					throw std::invalid_argument("Invalid row given!");
-				Data d(std::stod(currData));
-				res.addColumn(d);
-			}
-			else if (isString(currData))
-			{
-				if (colTypes[ind] != "String")
-					throw std::invalid_argument("Invalid row given!");
-				Data d(currData);
-				res.addColumn(d);
-			}
-			else if (isDateTime(currData))
-			{
-				if (colTypes[ind] != "DateTime")
-					throw std::invalid_argument("Invalid row given!");
-				Data d(currData);
-				res.addColumn(d);
-			}
-			else
-				throw std::invalid_argument("Invalid row given!");
-			ind++;
-			currData.clear();
-		}
-		else
-			currData += str[i];
-	}
-
-	return res;
-}
-
-bool Table::isInteger(const string& data) const
-{
-	size_t i = 0;
-	if (data[i] == '-')
-	{
-		i++;
-		if (i == data.size()) return false;
-	}
-	for (i; i < data.size(); i++)
-		if (!isNumber(data[i])) return false;
-
-	return true;
-}
-
-bool Table::isDouble(const string& data) const
-{
-	size_t i = 0;
-	if (data[i] == '-')
-	{
-		i++;
-		if (i == data.size()) return false;
-	}
-	size_t dotsCnt = 0;
-	for (i; i < data.size(); i++)
-	{
-		if (data[i] == '.')
-			dotsCnt++;
-		else
-			if (!isNumber(data[i]))
-				return false;
-	}
-	if (dotsCnt != 1)
-		return false;
-
-	return true;
-}
-
-bool Table::isString(const string& data) const
-{
-	return data[0] == '\"' && data[data.size() - 1] == '\"';
-}
-
-bool Table::isDateTime(const std::string& str) const
-{
-	std::string day, month, year;
-
-	if (str.size() < 5)
-		return false;
-
-	size_t pipes = 0;
-	for (size_t i = 0; i < str.size(); i++)
-	{
-		if (str[i] == '-')
-			pipes++;
-	}
-	if (pipes != 2)
-		return false;
-
-	size_t ind = 0;
-
-	while (ind < str.size() && str[ind] != '-')
-	{
-		day += str[ind];
-		ind++;
-	}
-	ind++;
-
-	if (day.size() < 1 || day.size() > 2)
-		return false;
-
-	while (ind < str.size() && str[ind] != '-')
-	{
-		month += str[ind];
-		ind++;
-	}
-	ind++;
-
-	if (month.size() < 1 || month.size() > 2)
-		return false;
-
-	while (ind < str.size())
-	{
-		year += str[ind];
-		ind++;
-	}
-
-	if (year.size() < 1 || year.size() > 4)
-		return false;
-
-	return true;
-}
-
-vector<string> Table::parseExpression(const string& expression) const
-{
-	vector<string> res;
-	string currWord;
-
-	for (size_t i = 0; i < expression.size(); i++)
-	{
-		if (expression[i] == '(')
-		{
-			res.push_back("(");
-			continue;
-		}
-
-		if (expression[i] != ' ' && expression[i] != ')')
-		{
-			currWord += expression[i];
-		}
-
-		if ((expression[i] == ' ' || expression[i] == ')' || i == (expression.size() - 1)) && !currWord.empty())
-		{
-			res.push_back(currWord);
-			currWord.clear();
-		}
-
-		if (expression[i] == ')')
-		{
-			res.push_back(")");
-			continue;
-		}
-	}
-
-	return res;
-}
-
-bool Table::containsOnlyIndexedCols(const vector<string>& arr) const
-{
-	if (arr.size() == 0)
-		return false;
-
-	for (size_t i = 0; i < arr.size(); i++)
-	{
-		if (arr[i] == "AND" || arr[i] == "OR" || arr[i] == "NOT"
-			|| arr[i] == "<" || arr[i] == ">" || arr[i] == "<="
-			|| arr[i] == ">=" || arr[i] == "!=" || arr[i] == "==")
-			continue;
-
-		bool isColName = false;
-		bool isIndexedCol = false;
-
-		for (size_t j = 0; j < colNames.size(); j++)
-		{
-			if (arr[i] == colNames[j])
-			{
-				isColName = true;
-				break;
-			}
-		}
-
-		if (isColName)
-		{
-			for (size_t j = 0; j < indexedCols.size(); j++)
-			{
-				if (arr[i] == indexedCols[j])
-				{
-					isIndexedCol = true;
-					break;
-				}
-			}
-			if (!isIndexedCol) return false;
-		}
-	}
-	return true;
-}
-
-bool Table::checkRecordCondition(const Record& record, const vector<string>& expression) const
-{
-	stack<string> evaluationStack;
-	queue<string> postfixQueue;
-
-	// turning into postfix expression
-	for (size_t i = 0; i < expression.size(); i++)
-	{
-		if (isLogicalOpOrBracket(expression[i]))
-		{
-			if (expression[i] == "(")
-			{
-				evaluationStack.push(expression[i]);
-			}
-			else if (expression[i] == ")")
-			{
-				if (evaluationStack.empty())
-					throw std::exception("Invalid expression!");
-
-				while (evaluationStack.top() != "(")
-				{
-					if (evaluationStack.top() == "AND" || evaluationStack.top() == "OR" || evaluationStack.top() == "NOT")
-						postfixQueue.push(evaluationStack.top());
-
-					evaluationStack.pop();
-				}
-				evaluationStack.pop();
-			}
-			else if (expression[i] == "AND" || expression[i] == "OR" || expression[i] == "NOT")
-			{
-				while (!evaluationStack.empty() && precedence(evaluationStack.top()) > precedence(expression[i]))
-				{
-					postfixQueue.push(evaluationStack.top());
-					evaluationStack.pop();
-				}
-
-				evaluationStack.push(expression[i]);
-			}
-		}
-		else
-		{
-			string leftArg = expression[i];
-			string oper = expression[i + 1];
-			string type = checkRightType(expression[i + 2]);
-			Data rightArg;
-			if (type == "")
-			{
-				throw std::exception("Invalid type!");
-			}
-			else if (type == "Int")
-			{
-				rightArg.setValue(std::stoi(expression[i + 2]));
-			}
-			else if (type == "Double")
-			{
-				rightArg.setValue(std::stod(expression[i + 2]));
-			}
-			else if (type == "String")
-			{
-				rightArg.setValue(expression[i + 2]);
-			}
-			else if (type == "DateTime")
-			{
-				rightArg.setValue(expression[i + 2]);
-			}
-
-			if (evaluate(leftArg, oper, rightArg, record))
-				postfixQueue.push("true");
-			else
-				postfixQueue.push("false");
-
-			i += 2;
-		}
-	}
-
-	while (!evaluationStack.empty())
-	{
-		postfixQueue.push(evaluationStack.top());
-		evaluationStack.pop();
-	}
-
-	stack<string> resultStack;
-
-	// getting the result
-	while (!postfixQueue.empty())
-	{
-		if (postfixQueue.front() == "true" || postfixQueue.front() == "false")
-		{
-			resultStack.push(postfixQueue.front());
-			postfixQueue.pop();
-		}
-		else if (postfixQueue.front() == "AND" || postfixQueue.front() == "OR")
-		{
-			if (resultStack.size() >= 2)
-			{
-				string first = resultStack.top();
-				resultStack.pop();
-
-				string second = resultStack.top();
-				resultStack.pop();
-
-				evaluateANDOR(first, second, postfixQueue.front());
-				resultStack.push(second);
-
-				postfixQueue.pop();
-			}
-			else
-				throw std::exception("Not enough arguments for binary expression!");
-		}
-		else if (postfixQueue.front() == "NOT")
-		{
-			if (resultStack.size() >= 1)
-			{
-				string first = resultStack.top();
-				resultStack.pop();
-
-				evaluateNOT(first, postfixQueue.front());
-				resultStack.push(first);
-
-				postfixQueue.pop();
-			}
-			else
-				throw std::exception("Not enough arguments for unary expression!");
-		}
-	}
-
-	if (resultStack.size() != 1 || (resultStack.top() != "true" && resultStack.top() != "false"))
-		throw std::exception("Invalid expression!");
-
-	return resultStack.top() == "true" ? true : false;
-}
-
-size_t Table::precedence(const string& arg) const
-{
-	if (arg == "NOT")
-		return 3;
-	else if (arg == "AND")
-		return 2;
-	else if (arg == "OR")
-		return 1;
-
-	return 0;
-}
-
-string Table::checkRightType(const string& data) const
-{
-	if (isInteger(data))
-	{
-		return "Int";
-	}
-	else if (isDouble(data))
-	{
-		return "Double";
-	}
-	else if (isString(data))
-	{
-		return "String";
-	}
-	else if (isDateTime(data))
-	{
-		return "DateTime";
-	}
-
-	return "";
-}
-
-void Table::evaluateANDOR(const string& first, string& second, const string& oper) const
-{
-	bool leftArg = first == "true" ? true : false;
-	bool rightArg = second == "true" ? true : false;
-	if (oper == "AND")
-	{
-		rightArg = leftArg && rightArg;
-	}
-	else if (oper == "OR")
-	{
-		rightArg = leftArg || rightArg;
-	}
-
-	rightArg == true ? second = "true" : second = "false";
-}
-
-void Table::evaluateNOT(string& first, const string& oper) const
-{
-	bool arg = first == "true" ? true : false;
-	if (oper == "NOT")
-		arg = !arg;
-
-	first = arg == true ? "true" : "false";
-}
-
-bool Table::evaluate(const string& leftArg, const string& oper, const Data& rightArg, const Record& record) const
-{
-	if (colNameIndexHT.find(leftArg) == colNameIndexHT.end())
-		throw std::exception("Given column doesn't exist!");
-
-	Data recData = record.getColData(colNameIndexHT.at(leftArg));
-
-	if (oper == ">")
-		return recData > rightArg;
-	else if (oper == "<")
-		return recData < rightArg;
-	else if (oper == ">=")
-		return recData >= rightArg;
-	else if (oper == "<=")
-		return recData <= rightArg;
-	else if (oper == "==")
-		return recData == rightArg;
-	else if (oper == "!=")
-		return recData != rightArg;
-
-	return false;
-}
-
-void Table::unite(const set<RecordPtr>& first, set<RecordPtr>& second) const
-{
-	for (const RecordPtr& elem : first)
-		second.insert(elem);
-}
-
-void Table::intersect(const set<RecordPtr>& first, set<RecordPtr>& second) const
-{
-	for (set<RecordPtr>::iterator it = second.begin(); it != second.end();)
-	{
-		if (first.find(*it) == first.end())
-			it = second.erase(it);
-		else
-			++it;
-	}
-}
-
-void Table::complement(set<RecordPtr>& first, const string& colName) const
-{
-	set<RecordPtr> all = indexedColsRecordsHT.at(colName)
-		.getElementsInRangeInSet(indexedColsRecordsHT.at(colName).min(), indexedColsRecordsHT.at(colName).max());
-
-	for (const RecordPtr& elem : all)
-	{
-		if (first.find(elem) == first.end())
-			first.insert(elem);
-		else
-			first.erase(elem);
-	}
-}
-
-vector<RecordPtr> Table::getIntervals(const vector<string>& expressionArr) const
-{
-	vector<RecordPtr> result;
-	stack<string> evaluationStack;
-	queue<string> postfixQueue;
-
-	// constructing the intervals and turning into postfix expression
-	for (size_t i = 0; i < expressionArr.size(); i++)
-	{
-		if (isLogicalOpOrBracket(expressionArr[i]))
-		{
-			if (expressionArr[i] == "(")
-			{
-				evaluationStack.push(expressionArr[i]);
-			}
-			else if (expressionArr[i] == ")")
-			{
-				if (evaluationStack.empty())
-					throw std::exception("Invalid expression!");
-
-				while (evaluationStack.top() != "(")
-				{
-					if (evaluationStack.top() == "AND" || evaluationStack.top() == "OR" || evaluationStack.top() == "NOT")
-						postfixQueue.push(evaluationStack.top());
-
-					evaluationStack.pop();
-				}
-				evaluationStack.pop();
-			}
-			else if (expressionArr[i] == "AND" || expressionArr[i] == "OR" || expressionArr[i] == "NOT")
-			{
-				while (!evaluationStack.empty() && precedence(evaluationStack.top()) > precedence(expressionArr[i]))
-				{
-					postfixQueue.push(evaluationStack.top());
-					evaluationStack.pop();
-				}
-
-				evaluationStack.push(expressionArr[i]);
-			}
-		}
-		else
-		{
-			string colName = expressionArr[i];
-			string oper = expressionArr[i + 1];
-			string type = checkRightType(expressionArr[i + 2]);
-			Data bound;
-			if (type == "")
-			{
-				throw std::exception("Invalid type!");
-			}
-			else if (type == "Int")
-			{
-				bound.setValue(std::stoi(expressionArr[i + 2]));
-			}
-			else if (type == "Double")
-			{
-				bound.setValue(std::stod(expressionArr[i + 2]));
-			}
-			else if (type == "String")
-			{
-				bound.setValue(expressionArr[i + 2]);
-			}
-			else if (type == "DateTime")
-			{
-				bound.setValue(expressionArr[i + 2]);
-			}
-			if (oper == "!=")
-			{
-				Data temp = bound;
-				Interval interval1 = buildInterval(colName, bound, "<", type);
-				Interval interval2 = buildInterval(colName, temp, ">", type);
-				postfixQueue.push(interval1.toString());
-				postfixQueue.push(interval2.toString());
-				postfixQueue.push("OR");
-			}
-			else
-			{
-				Interval interval = buildInterval(colName, bound, oper, type);
-				postfixQueue.push(interval.toString());
-			}
-
-
-			i += 2;
-		}
-	}
-
-	while (!evaluationStack.empty())
-	{
-		postfixQueue.push(evaluationStack.top());
-		evaluationStack.pop();
-	}
-
-	stack<pair<string, set<RecordPtr>>> resultStack;
-
-	size_t count = 1;
-
-	// getting the result
-	while (!postfixQueue.empty())
-	{
-		if (postfixQueue.front() != "AND" && postfixQueue.front() != "OR" && postfixQueue.front() != "NOT")
-		{
-			Interval interval(postfixQueue.front());
-			string colName = interval.getColName();
-			set<RecordPtr> set;
-			if (!interval.isEmpty())
-			{
-				set = indexedColsRecordsHT.at(colName).getElementsInRangeInSet(interval.getLeftBound(), interval.getRightBound());
-			}
-			resultStack.push({ colName, set });
-			postfixQueue.pop();
-		}
-		else if (postfixQueue.front() == "AND")
-		{
-			if (resultStack.size() >= 2)
-			{
-				set<RecordPtr> firstSet = resultStack.top().second;
-				resultStack.pop();
-
-				string colName = resultStack.top().first;
-				set<RecordPtr> secondSet = resultStack.top().second;
-				resultStack.pop();
-
-				intersect(firstSet, secondSet);
-
-				resultStack.push({ colName, secondSet });
-
-				postfixQueue.pop();
-			}
-			else
-				throw std::exception("Not enough arguments for binary expression!");
-		}
-		else if (postfixQueue.front() == "OR")
-		{
-			if (resultStack.size() >= 2)
-			{
-				set<RecordPtr> firstSet = resultStack.top().second;
-				resultStack.pop();
-
-				string colName = resultStack.top().first;
-				set<RecordPtr> secondSet = resultStack.top().second;
-				resultStack.pop();
-
-				unite(firstSet, secondSet);
-
-				resultStack.push({ colName, secondSet });
-
-				postfixQueue.pop();
-			}
-			else
-				throw std::exception("Not enough arguments for binary expression!");
-		}
-		else if (postfixQueue.front() == "NOT")
-		{
-			if (evaluationStack.size() >= 1)
-			{
-				string colName = resultStack.top().first;
-				set<RecordPtr> firstSet = resultStack.top().second;
-				resultStack.pop();
-
-				complement(firstSet, colName);
-
-				resultStack.push({ colName, firstSet });
-
-				postfixQueue.pop();
-			}
-			else
-				throw std::exception("Not enough arguments for unary expression!");
-		}
-	}
-
-	if (resultStack.size() != 1)
-		throw std::exception("Invalid expression!");
-
-	for (const RecordPtr& el : resultStack.top().second)
-		result.push_back(el);
-
-	return result;
-}
-
-Interval Table::buildInterval(const string& colName, Data& bound, const string& oper, const string& type) const
-{
-	if (oper == ">")
-	{
-		Data rightBound = indexedColsRecordsHT.at(colName).max();
-		bound = indexedColsRecordsHT.at(colName).getNextGreaterThan(bound);
-		if (!bound.getValue())
-		{
-			return Interval(rightBound, rightBound, colName, type, true);
-		}
-		Interval interval(bound, rightBound, colName, type, false);
-		return interval;
-	}
-	else if (oper == ">=")
-	{
-		if (bound < indexedColsRecordsHT.at(colName).min())
-		{
-			return Interval(bound, bound, colName, type, true);
-		}
-		Data rightBound = indexedColsRecordsHT.at(colName).max();
-		Interval interval(bound, rightBound, colName, type, false);
-		return interval;
-	}
-	else if (oper == "<")
-	{
-		Data leftBound = indexedColsRecordsHT.at(colName).min();
-		bound = indexedColsRecordsHT.at(colName).getPrevLesserThan(bound);
-		if (!bound.getValue())
-		{
-			return Interval(leftBound, leftBound, colName, type, true);
-		}
-		Interval interval(leftBound, bound, colName, type, false);
-		return interval;
-	}
-	else if (oper == "<=")
-	{
-		if (bound > indexedColsRecordsHT.at(colName).max())
-		{
-			return Interval(bound, bound, colName, type, true);
-		}
-		Data leftBound = indexedColsRecordsHT.at(colName).min();
-		Interval interval(leftBound, bound, colName, type, false);
-		return interval;
-	}
-	else if (oper == "==")
-	{
-		if (!bound.getValue())
-		{
-			return Interval(Data(), Data(), colName, type, true);
-		}
-		return Interval(bound, bound, colName, type, false);
-	}
-	else
-		throw std::invalid_argument("Invalid operation given!");
-}
-
-bool Table::areSorted(const vector<RecordPtr>& recordPtrs) const
-{
-	for (size_t i = 0; i < recordPtrs.size() - 1; i++)
-	{
-		if (recordPtrs[i] > recordPtrs[i + 1])
-			return false;
-	}
-
-	return true;
-}
-
-void Table::transformToRecords(vector<RecordPtr>& recordPtrs, vector<Record>& records) const
-{
-	if (recordPtrs.empty())
-		return;
-
-	if (!areSorted(recordPtrs))
-		heapSortRecordPtrs(recordPtrs);
-
-	for (size_t i = 0; i < recordPtrs.size(); i++)
-	{
-		size_t num = recordPtrs[i].pageNumber();
-		ifstream in(name + "_page" + std::to_string(recordPtrs[i].pageNumber()) + ".bin", std::ios::binary);
-		if (!in)
-			throw std::exception("Couldn't open page for reading!");
-
-		Page page(in);
-
-		if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-		{
-			while (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-			{
-				records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-				i++;
-			}
-			if (i < recordPtrs.size() && recordPtrs[i].pageNumber() == num)
-			{
-				records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-			}
-		}
-		else if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() != recordPtrs[i + 1].pageNumber())
-		{
-			records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-		}
-		else if (i == recordPtrs.size() - 1)
-		{
-			records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-		}
-
-		in.close();
-	}
-}
-
-void Table::checkCondAndTransformToRecords(vector<RecordPtr>& recordPtrs, vector<Record>& records, const vector<string>& expression) const
-{
-	if (recordPtrs.empty())
-		return;
-
-	if (!areSorted(recordPtrs))
-		heapSortRecordPtrs(recordPtrs);
-
-	for (size_t i = 0; i < recordPtrs.size(); i++)
-	{
-		size_t num = recordPtrs[i].pageNumber();
-		ifstream in(name + "_page" + std::to_string(recordPtrs[i].pageNumber()) + ".bin", std::ios::binary);
-		if (!in)
-			throw std::exception("Couldn't open page for reading!");
-
-		Page page(in);
-
-		if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-		{
-			while (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() == recordPtrs[i + 1].pageNumber())
-			{
-				if (expression.empty() || checkRecordCondition(page.getRecord(recordPtrs[i].rowNumber()), expression))
-					records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-				i++;
-			}
-			if (i < recordPtrs.size() && recordPtrs[i].pageNumber() == num)
-			{
-				if (expression.empty() || checkRecordCondition(page.getRecord(recordPtrs[i].rowNumber()), expression))
-					records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-			}
-		}
-		else if (i < recordPtrs.size() - 1 && recordPtrs[i].pageNumber() != recordPtrs[i + 1].pageNumber())
-		{
-			if (expression.empty() || checkRecordCondition(page.getRecord(recordPtrs[i].rowNumber()), expression))
-				records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-		}
-		else if (i == recordPtrs.size() - 1)
-		{
-			if (expression.empty() || checkRecordCondition(page.getRecord(recordPtrs[i].rowNumber()), expression))
-				records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
-		}
-
-		in.close();
-	}
-}
-
-void Table::orderBy(vector<Record>& records, const string colName) const
-{
-	if (colNameIndexHT.find(colName) == colNameIndexHT.end())
-		throw std::invalid_argument("Column doesn't exist in the table!");
-
-	heapSortRecords(records, colName);
-}
-
-void Table::heapSortRecords(vector<Record>& records, const string colName) const
-{
-	int size = records.size();
-	for (int i = size / 2 - 1; i >= 0; i--)
-		heapifyRecords(records, size, i, colNameIndexHT.at(colName));
-
-	for (int i = size - 1; i > 0; i--) {
-		swap(records[0], records[i]);
-		heapifyRecords(records, i, 0, colNameIndexHT.at(colName));
-	}
-}
-
-void Table::heapifyRecords(vector<Record>& records, int size, int i, size_t colInd) const
-{
-	int largest = i;
-	int left = 2 * i + 1;
-	int right = 2 * i + 2;
-
-	if (left < size && records[left].getColData(colInd) > records[largest].getColData(colInd))
-		largest = left;
-
-	if (right < size && records[right].getColData(colInd) > records[largest].getColData(colInd))
-		largest = right;
-
-	if (largest != i) {
-		swap(records[i], records[largest]);
-		heapifyRecords(records, size, largest, colInd);
-	}
-}
-
-void Table::heapSortRecordPtrs(vector<RecordPtr>& recordPtrs) const
-{
-	int size = recordPtrs.size();
-	for (int i = size / 2 - 1; i >= 0; i--)
-		heapifyRecordPtrs(recordPtrs, size, i);
-
-	for (int i = size - 1; i > 0; i--) {
-		swap(recordPtrs[0], recordPtrs[i]);
-		heapifyRecordPtrs(recordPtrs, i, 0);
-	}
-}
-
-void Table::heapifyRecordPtrs(vector<RecordPtr>& recordPtrs, int size, int i) const
-{
-	int largest = i;
-	int left = 2 * i + 1;
-	int right = 2 * i + 2;
-
-	if (left < size && recordPtrs[left] > recordPtrs[largest])
-		largest = left;
-
-	if (right < size && recordPtrs[right] > recordPtrs[largest])
-		largest = right;
-
-	if (largest != i) {
-		swap(recordPtrs[i], recordPtrs[largest]);
-		heapifyRecordPtrs(recordPtrs, size, largest);
-	}
-}
-
-vector<string> Table::parseColsToPrint(const string& toPrint) const
-{
-	vector<string> res;
-	string currCol;
-
-	for (size_t i = 0; i < toPrint.size(); i++)
-	{
-		if (toPrint[i] != ' ')
-			currCol += toPrint[i];
-		else
-		{
-			res.push_back(currCol);
-			currCol.clear();
-		}
-
-		if (i == toPrint.size() - 1)
-			res.push_back(currCol);
-	}
-
-	return res;
-}
-
-void Table::makeDistinct(const string& toPrint, vector<string>& result, const vector<Record>& selected) const
-{
-	if (toPrint == "*")
-	{
-		for (size_t i = 0; i < selected.size(); i++)
-		{
-			string currRow;
-			for (size_t j = 0; j < selected[i].size(); j++)
-				currRow += selected[i].getColData(j).toString() + ' ';
-
-			currRow.pop_back();
-			bool found = false;
-			for (size_t i = 0; i < result.size(); i++)
-			{
-				if (result[i] == currRow)
-				{
-					found = true;
-					break;
-				}
-			}
-			if (!found)
-				result.push_back(currRow);
-		}
-	}
-	else
-	{
-		vector<string> colsToPrint = parseColsToPrint(toPrint);
-
-		for (size_t i = 0; i < selected.size(); i++)
-		{
-			string currRow;
-			for (size_t j = 0; j < colsToPrint.size(); j++)
-			{
-				if (colNameIndexHT.find(colsToPrint[j]) == colNameIndexHT.end())
-					throw std::invalid_argument("Invalid column name!");
-
-				currRow += selected[i].getColData(colNameIndexHT.at(colsToPrint[j])).toString() + ' ';
-			}
-			currRow.pop_back();
-			bool found = false;
-			for (size_t i = 0; i < result.size(); i++)
-			{
-				if (result[i] == currRow)
-				{
-					found = true;
-					break;
-				}
-			}
-			if (!found)
-				result.push_back(currRow);
-		}
-	}
-}
-
-void Table::notDistinct(const string& toPrint, vector<string>& result, const vector<Record>& selected) const
-{
-	if (toPrint == "*")
-	{
-		for (size_t i = 0; i < selected.size(); i++)
-		{
-			string currRow;
-			for (size_t j = 0; j < selected[i].size(); j++)
-				currRow += selected[i].getColData(j).toString() + ' ';
-
-			currRow.pop_back();
-			result.push_back(currRow);
-		}
-	}
-	else
-	{
-		vector<string> colsToPrint = parseColsToPrint(toPrint);
-
-		for (size_t i = 0; i < selected.size(); i++)
-		{
-			string currRow;
-			for (size_t j = 0; j < colsToPrint.size(); j++)
-			{
-				if (colNameIndexHT.find(colsToPrint[j]) == colNameIndexHT.end())
-					throw std::exception("Invalid column name!");
-
-				currRow += selected[i].getColData(colNameIndexHT.at(colsToPrint[j])).toString() + ' ';
-			}
-			currRow.pop_back();
-			result.push_back(currRow);
-		}
-	}
-}
+#include "Table.h"
+#include <filesystem>
+
+Table::Table()
+	: name("")
+	, currPageNumber(0)
+	, pageSize(PAGE_SIZE)
+	, bytes(0)
+{}
+
+Table::Table(const string& header, const string& name, const string& firstIndexedCol, size_t pageSize)
+	: name(name)
+	, currPageNumber(0)
+	, pageSize(pageSize)
+	, bytes(0)
+{
+	// 4, 8, 16, 32 or 64 KiB
+	if (pageSize < PAGE_SIZE || pageSize > MAX_PAGE_SIZE || (pageSize & (pageSize - 1)) != 0)
+		throw std::invalid_argument("Invalid page size!");
+
+	setCollections(header);
+	bloomBitsPerKey.resize(colNames.size(), 0);
+	if (!firstIndexedCol.empty())
+
+		indexedCols.push_back(firstIndexedCol);
+	else
+		indexedCols.push_back(colNames[0]);
+	indexedColsRecordsHT.insert({ indexedCols[0], BPlusTree() });
+	BufferPool::i().createSegment(name, pageSize);
+	createPage();
+	serialize();
+}
+
+Table::Table(std::ifstream& in)
+{
+	size_t len;
+	in.read((char*)&len, sizeof(len));
+
+	// files without the mark are from before the version was saved
+	uint32_t version = 1;
+	if (len == TABLE_FILE_MARK)
+	{
+		in.read((char*)&version, sizeof(version));
+		if (version > TABLE_FILE_VERSION)
+			throw std::exception("Unsupported table file version!");
+		in.read((char*)&len, sizeof(len));
+	}
+
+	name.resize(len);
+	in.read((char*)&name[0], len);
+
+	in.read((char*)&currPageNumber, sizeof(currPageNumber));
+	in.read((char*)&bytes, sizeof(bytes));
+
+	// the pages had 10 records of at most 4 KiB before version 5, the old pages keep their limit
+	pageSize = PAGE_SIZE;
+	if (version >= 5)
+		in.read((char*)&pageSize, sizeof(pageSize));
+
+	// every page had its own file before version 6, the pages are moved to the segment file of the table once
+	if (version < 6)
+		pageSize = BufferPool::i().importPages(name, currPageNumber, pageSize);
+	else
+		BufferPool::i().openSegment(name, pageSize);
+
+	in.read((char*)&len, sizeof(len));
+	colNames.reserve(len);
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size;
+		in.read((char*)&size, sizeof(size));
+
+		string colName;
+		colName.resize(size);
+		in.read((char*)&colName[0], size);
+		colNames.push_back(colName);
+	}
+
+	in.read((char*)&len, sizeof(len));
+	colTypes.reserve(len);
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size;
+		in.read((char*)&size, sizeof(size));
+
+		string colType;
+		colType.resize(size);
+		in.read((char*)&colType[0], size);
+		colTypes.push_back(colType);
+	}
+
+	in.read((char*)&len, sizeof(len));
+	indexedCols.reserve(len);
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size;
+		in.read((char*)&size, sizeof(size));
+
+		string colName;
+		colName.resize(size);
+		in.read((char*)&colName[0], size);
+		indexedCols.push_back(colName);
+	}
+
+	in.read((char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size;
+		in.read((char*)&size, sizeof(size));
+		string first;
+		first.resize(size);
+		in.read((char*)&first[0], size);
+
+		size_t second;
+		in.read((char*)&second, sizeof(second));
+
+		colNameIndexHT.insert({ first,second });
+	}
+
+	in.read((char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size;
+		in.read((char*)&size, sizeof(size));
+		string colName;
+		colName.resize(size);
+		in.read((char*)&colName[0], size);
+
+		// the keys were saved with the names of their types before version 2
+		BPlusTree column(in, version < 2);
+		indexedColsRecordsHT[colName] = column;
+	}
+
+	bloomBitsPerKey.resize(colNames.size(), 0);
+	if (version >= 4)
+		in.read((char*)&bloomBitsPerKey[0], bloomBitsPerKey.size() * sizeof(size_t));
+
+	if (version >= 3)
+	{
+		// the zone maps got Bloom filters in version 4
+		in.read((char*)&len, sizeof(len));
+		zoneMaps.reserve(len);
+		for (size_t i = 0; i < len; i++)
+			zoneMaps.push_back(ZoneMap(in, version >= 4));
+	}
+	else
+	{
+		// older tables have no zone maps, so they are built from the pages once
+		zoneMaps.resize(currPageNumber, ZoneMap(colNames.size()));
+		for (size_t i = 1; i <= currPageNumber; i++)
+			updateZoneMap(i, BufferPool::i().getPage(name, i));
+	}
+
+	// the Bloom filters hashed the strings with the case of their letters before version 8, so they are filled again
+	bool caseFilters = false;
+	for (size_t i = 0; i < colTypes.size(); i++)
+		caseFilters = caseFilters || (colTypes[i] == "String" && bloomBitsPerKey[i] > 0);
+
+	if (version < 8 && caseFilters)
+	{
+		for (size_t i = 1; i <= currPageNumber; i++)
+			updateZoneMap(i, BufferPool::i().getPage(name, i));
+	}
+
+	if (version >= 7)
+		freeSpaceMap = FreeSpaceMap(in);
+	else
+	{
+		// only the last page and the pages with removed rows can have space for a row
+		for (size_t i = 1; i <= currPageNumber; i++)
+		{
+			bool hasSpace = i == currPageNumber || zoneMaps[i - 1].getRemovedRows() > 0;
+			freeSpaceMap.update(i, hasSpace ? BufferPool::i().getPage(name, i).availableSpace() : 0);
+		}
+	}
+
+	// every row is in every index, so the live rows are taken from the first one
+	const BPlusTree& firstIndex = indexedColsRecordsHT.at(indexedCols[0]);
+	if (!firstIndex.isEmpty())
+		liveRows = RowBitmap(firstIndex.getElementsInRange(firstIndex.min(), firstIndex.max()));
+}
+
+void Table::insert(const vector<string>& recordStr)
+{
+	// parse all of the records first so an invalid row doesn't leave the statement half inserted
+	vector<Record> records;
+	records.reserve(recordStr.size());
+	for (size_t i = 0; i < recordStr.size(); i++)
+	{
+		records.push_back(toRecord(recordStr[i]));
+		if (records[i].size() != colNames.size())
+			throw std::invalid_argument("Invalid row given!");
+		if (records[i].encodedSize(false) > Page::maxRecordSize(pageSize, colNames.size()))
+			throw std::invalid_argument("Row is too big for a page!");
+	}
+
+	insertRecords(records);
+}
+
+void Table::insertRecords(const vector<Record>& records)
+{
+	vector<vector<BPlusTree::Kvp>> indexBatches(indexedCols.size());
+	for (size_t k = 0; k < indexedCols.size(); k++)
+		indexBatches[k].reserve(records.size());
+
+	Page* page = nullptr;
+	size_t pageNum = 0;
+
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		// a row goes to the first page with space for it, so the space of removed rows is filled before the last page
+		if (page == nullptr || !page->canInsert(records[i]))
+		{
+			if (page != nullptr)
+			{
+				BufferPool::i().markDirty(name, pageNum);
+				freeSpaceMap.update(pageNum, page->availableSpace());
+			}
+
+			// the size with type tags is never smaller than the size in a page
+			pageNum = freeSpaceMap.findPage(records[i].encodedSize(true));
+			if (pageNum == 0)
+			{
+				page = &createPage();
+				pageNum = currPageNumber;
+			}
+			else
+				page = &BufferPool::i().getPage(name, pageNum);
+		}
+
+		// the slot of a removed row is free to take, it isn't in the indexes anymore
+		if (page->hasEmptySlot())
+			zoneMaps[pageNum - 1].reuseRemoved();
+
+		RecordPtr recPtr(pageNum, page->insertRecord(records[i]));
+		zoneMaps[pageNum - 1].add(records[i]);
+		bytes += records[i].getBytes();
+		liveRows.add(recPtr);
+
+		for (size_t k = 0; k < indexedCols.size(); k++)
+			indexBatches[k].push_back({ records[i].getColData(colNameIndexHT[indexedCols[k]]), recPtr });
+	}
+
+	if (page != nullptr)
+	{
+		BufferPool::i().markDirty(name, pageNum);
+		freeSpaceMap.update(pageNum, page->availableSpace());
+	}
+
+	for (size_t k = 0; k < indexedCols.size(); k++)
+		indexedColsRecordsHT[indexedCols[k]].insertBatch(std::move(indexBatches[k]));
+}
+
+size_t Table::select(const string& expression, const string& orderByWhat, bool distinct, const string& toPrint,
+	const function<void(const string&)>& sink, size_t limit) const
+{
+	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
+		return 0;
+
+	vector<string> indexedExpr;
+	vector<string> residualExpr;
+	splitConjuncts(parseExpression(expression), indexedExpr, residualExpr);
+
+	vector<string> colsToPrint = getColsNamesToPrint(toPrint);
+	for (size_t i = 0; i < colsToPrint.size(); i++)
+	{
+		if (colNameIndexHT.find(colsToPrint[i]) == colNameIndexHT.end())
+			throw std::invalid_argument("Invalid column name!");
+	}
+
+	// the printed columns and the columns of the order after them if they aren't printed
+	vector<string> scanCols = colsToPrint;
+	vector<SortKey> orderKeys = parseOrderBy(orderByWhat, scanCols);
+	vector<SortKey> distinctOrder = distinct ? orderKeys : vector<SortKey>();
+
+	vector<size_t> colInds;
+	vector<const BPlusTree*> indexes;
+	for (size_t i = 0; i < scanCols.size(); i++)
+	{
+		colInds.push_back(colNameIndexHT.at(scanCols[i]));
+		if (indexedColsRecordsHT.count(scanCols[i]))
+			indexes.push_back(&indexedColsRecordsHT.at(scanCols[i]));
+	}
+
+	// an ascending order by one indexed column is the order of the leaves of its index
+	string indexOrderCol = orderKeys.size() == 1 && !orderKeys[0].descending && indexedColsRecordsHT.count(scanCols[orderKeys[0].colInd])
+		? scanCols[orderKeys[0].colInd]
+		: "";
+
+	// the rows of the conditions on indexed columns (all live rows if there are none)
+	RowBitmap rows = indexedExpr.empty() ? liveRows : RowBitmap(getIntervals(indexedExpr));
+
+	// a query that uses only indexed columns is answered from the leaves of the indexes without reading any page,
+	// unless the walks of the leaves cost more than reading the selected rows
+	vector<IndexBounds> bounds;
+	bool indexOnly = residualExpr.empty() && indexes.size() == scanCols.size();
+	if (indexOnly)
+	{
+		for (size_t i = 0; i < scanCols.size(); i++)
+			bounds.push_back(indexBounds(indexedExpr, scanCols[i]));
+		indexOnly = useIndexOnly(rows, bounds, limit);
+	}
+
+	Predicate condition = compileCondition(residualExpr);
+	unique_ptr<Operator> plan;
+
+	if (indexOnly)
+	{
+		// the rows are given in the order of the leaves of the index of the order column, so they aren't sorted
+		size_t orderCol = IndexOnlyScan::NO_ORDER;
+		if (indexOrderCol != "")
+			orderCol = orderKeys[0].colInd;
+
+		plan = std::make_unique<IndexOnlyScan>(rows, std::move(indexes), std::move(bounds), orderCol);
+
+		if (indexOrderCol == "" && !orderKeys.empty())
+			plan = std::make_unique<Sort>(std::move(plan), std::move(orderKeys));
+	}
+	else if (indexOrderCol != "" && cheapWalk(rows, indexBounds(indexedExpr, indexOrderCol), distinct ? NO_LIMIT : limit))
+	{
+		// the rows are fetched in the order of the leaves of the index of the order column, so they aren't sorted
+		// and a LIMIT stops the fetching after the first rows
+		plan = std::make_unique<IndexScan>(name, indexedColsRecordsHT.at(indexOrderCol), rows,
+			indexBounds(indexedExpr, indexOrderCol));
+
+		if (!condition.isEmpty())
+		{
+			plan = std::make_unique<Filter>(std::move(plan),
+				[condition](const Record& record) { return condition.matches(record); });
+		}
+		plan = std::make_unique<Project>(std::move(plan), std::move(colInds));
+	}
+	else
+	{
+		// index scan -> fetch -> filter -> project -> sort, every stage pulls rows from the one before it
+		plan = std::make_unique<Project>(scanPlan(indexedExpr, rows, condition), std::move(colInds));
+
+		// only the first rows of the order are needed for a LIMIT, so they are kept in a bounded heap
+		// (unless the same rows are left out after the order)
+		if (!orderKeys.empty() && limit != NO_LIMIT && !distinct)
+			plan = std::make_unique<TopK>(std::move(plan), std::move(orderKeys), limit);
+		else if (!orderKeys.empty())
+			plan = std::make_unique<Sort>(std::move(plan), std::move(orderKeys));
+	}
+
+	// the first of the same printed rows in the order of the stages before is given, as soon as it is read
+	if (distinct)
+		plan = std::make_unique<HashDistinct>(std::move(plan), colsToPrint.size(), std::move(distinctOrder));
+
+	// the columns of the order are left out if they aren't printed
+	if (scanCols.size() != colsToPrint.size())
+	{
+		vector<size_t> printInds(colsToPrint.size());
+		for (size_t i = 0; i < printInds.size(); i++)
+			printInds[i] = i;
+		plan = std::make_unique<Project>(std::move(plan), std::move(printInds));
+	}
+
+	if (limit != NO_LIMIT)
+		plan = std::make_unique<Limit>(std::move(plan), limit);
+
+	size_t count = 0;
+	Record row;
+	while (plan->next(row))
+	{
+		sink(Operator::toRow(row));
+		count++;
+	}
+
+	return count;
+}
+
+size_t Table::aggregate(const string& expression, const string& groupBy, const string& toPrint, const string& orderByWhat,
+	const function<void(const string&)>& sink, size_t limit) const
+{
+	vector<string> groupCols = parseColsToPrint(groupBy);
+	for (size_t i = 0; i < groupCols.size(); i++)
+	{
+		if (colNameIndexHT.find(groupCols[i]) == colNameIndexHT.end())
+			throw std::invalid_argument("Invalid column name!");
+	}
+
+	// the rows of the aggregation are the columns of the groups followed by the aggregates,
+	// every shown item is one of them
+	vector<string> items = getColsNamesToPrint(toPrint);
+	vector<Aggregate> aggregates;
+	vector<size_t> itemInds;
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		Aggregate aggregate;
+		if (parseAggregate(items[i], aggregate))
+		{
+			itemInds.push_back(groupCols.size() + aggregates.size());
+			aggregates.push_back(aggregate);
+			continue;
+		}
+
+		size_t ind = std::find(groupCols.begin(), groupCols.end(), items[i]) - groupCols.begin();
+		if (ind == groupCols.size())
+			throw std::invalid_argument("Column must be in GROUP BY!");
+
+		itemInds.push_back(ind);
+	}
+
+	vector<SortKey> orderKeys = parseOrderBy(orderByWhat, items, false);
+
+	vector<string> indexedExpr;
+	vector<string> residualExpr;
+	splitConjuncts(parseExpression(expression), indexedExpr, residualExpr);
+
+	// COUNT(*) is the count of the rows and COUNT, MIN and MAX of an indexed column of all rows are in its index,
+	// so the single row of such aggregates is given without reading any page
+	bool fromIndexes = groupCols.empty();
+	for (size_t i = 0; i < aggregates.size() && fromIndexes; i++)
+	{
+		if (aggregates[i].colInd == COUNT_ALL)
+			continue;
+
+		fromIndexes = indexedExpr.empty() && residualExpr.empty() && aggregates[i].func != AggregateFunc::Sum
+			&& aggregates[i].func != AggregateFunc::Avg && indexedColsRecordsHT.count(colNames[aggregates[i].colInd]);
+	}
+
+	if (fromIndexes)
+	{
+		Record row;
+		for (size_t i = 0; i < aggregates.size(); i++)
+		{
+			if (aggregates[i].colInd == COUNT_ALL)
+			{
+				row.addColumn(Data((int)count(expression)));
+				continue;
+			}
+
+			const BPlusTree& index = indexedColsRecordsHT.at(colNames[aggregates[i].colInd]);
+			if (aggregates[i].func == AggregateFunc::Count)
+				row.addColumn(Data((int)index.getSize()));
+			else if (index.isEmpty())
+				row.addColumn(Data());
+			else
+				row.addColumn(aggregates[i].func == AggregateFunc::Min ? index.min() : index.max());
+		}
+
+		if (limit == 0)
+			return 0;
+
+		sink(Operator::toRow(row));
+		return 1;
+	}
+
+	// the rows are read with the columns of the groups followed by the columns of the aggregates
+	vector<string> scanCols = groupCols;
+	for (size_t i = 0; i < aggregates.size(); i++)
+	{
+		if (aggregates[i].colInd == COUNT_ALL)
+			continue;
+
+		const string& col = colNames[aggregates[i].colInd];
+		aggregates[i].colInd = std::find(scanCols.begin(), scanCols.end(), col) - scanCols.begin();
+		if (aggregates[i].colInd == scanCols.size())
+			scanCols.push_back(col);
+	}
+
+	vector<size_t> colInds;
+	vector<const BPlusTree*> indexes;
+	for (size_t i = 0; i < scanCols.size(); i++)
+	{
+		colInds.push_back(colNameIndexHT.at(scanCols[i]));
+		if (indexedColsRecordsHT.count(scanCols[i]))
+			indexes.push_back(&indexedColsRecordsHT.at(scanCols[i]));
+	}
+
+	unique_ptr<Operator> plan;
+	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
+		plan = std::make_unique<TableScan>(name, 0, nullptr);
+	else
+	{
+		RowBitmap rows = indexedExpr.empty() ? liveRows : RowBitmap(getIntervals(indexedExpr));
+
+		// the groups of indexed columns are built from the leaves of the indexes without reading any page
+		vector<IndexBounds> bounds;
+		bool indexOnly = residualExpr.empty() && indexes.size() == scanCols.size();
+		if (indexOnly)
+		{
+			for (size_t i = 0; i < scanCols.size(); i++)
+				bounds.push_back(indexBounds(indexedExpr, scanCols[i]));
+			indexOnly = useIndexOnly(rows, bounds, NO_LIMIT);
+		}
+
+		if (indexOnly)
+			plan = std::make_unique<IndexOnlyScan>(rows, std::move(indexes), std::move(bounds));
+		else
+			plan = std::make_unique<Project>(scanPlan(indexedExpr, rows, compileCondition(residualExpr)), std::move(colInds));
+	}
+
+	// the items are given in the order they are shown
+	bool sameOrder = itemInds.size() == groupCols.size() + aggregates.size();
+	for (size_t i = 0; i < itemInds.size() && sameOrder; i++)
+		sameOrder = itemInds[i] == i;
+
+	vector<size_t> groupInds(groupCols.size());
+	for (size_t i = 0; i < groupInds.size(); i++)
+		groupInds[i] = i;
+
+	plan = std::make_unique<HashAggregate>(std::move(plan), std::move(groupInds), std::move(aggregates));
+	if (!sameOrder)
+		plan = std::make_unique<Project>(std::move(plan), std::move(itemInds));
+
+	if (!orderKeys.empty() && limit != NO_LIMIT)
+		plan = std::make_unique<TopK>(std::move(plan), std::move(orderKeys), limit);
+	else if (!orderKeys.empty())
+		plan = std::make_unique<Sort>(std::move(plan), std::move(orderKeys));
+
+	if (limit != NO_LIMIT)
+		plan = std::make_unique<Limit>(std::move(plan), limit);
+
+	size_t count = 0;
+	Record row;
+	while (plan->next(row))
+	{
+		sink(Operator::toRow(row));
+		count++;
+	}
+
+	return count;
+}
+
+size_t Table::count(const string& expression) const
+{
+	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
+		return 0;
+
+	vector<string> indexedExpr;
+	vector<string> residualExpr;
+	splitConjuncts(parseExpression(expression), indexedExpr, residualExpr);
+
+	// the rows of a condition on indexed columns are counted without reading any page
+	if (residualExpr.empty())
+		return indexedExpr.empty() ? liveRows.size() : RowBitmap(getIntervals(indexedExpr)).size();
+
+	RowBitmap rows = indexedExpr.empty() ? RowBitmap() : RowBitmap(getIntervals(indexedExpr));
+	unique_ptr<Operator> plan = scanPlan(indexedExpr, rows, compileCondition(residualExpr));
+	size_t count = 0;
+	Record row;
+	while (plan->next(row))
+		count++;
+
+	return count;
+}
+
+vector<SortKey> Table::parseOrderBy(const string& orderByWhat, vector<string>& scanCols, bool addMissing) const
+{
+	vector<SortKey> keys;
+	if (orderByWhat == "")
+		return keys;
+
+	vector<string> words = parseColsToPrint(orderByWhat);
+	for (size_t i = 0; i < words.size(); i++)
+	{
+		if (words[i].empty())
+			continue;
+
+		if (words[i] == "ASC" || words[i] == "DESC")
+		{
+			if (keys.empty())
+				throw std::invalid_argument("Invalid ORDER BY!");
+
+			keys.back().descending = words[i] == "DESC";
+			continue;
+		}
+
+		size_t ind = std::find(scanCols.begin(), scanCols.end(), words[i]) - scanCols.begin();
+		if (ind == scanCols.size())
+		{
+			if (!addMissing)
+				throw std::invalid_argument("ORDER BY can use only the selected items!");
+			if (colNameIndexHT.find(words[i]) == colNameIndexHT.end())
+				throw std::invalid_argument("Column doesn't exist in the table!");
+
+			scanCols.push_back(words[i]);
+		}
+
+		keys.push_back({ ind, false });
+	}
+
+	// a column given again doesn't change the order
+	for (size_t i = 1; i < keys.size(); i++)
+	{
+		if (std::find_if(keys.begin(), keys.begin() + i, [&](const SortKey& key) { return key.colInd == keys[i].colInd; }) != keys.begin() + i)
+			keys.erase(keys.begin() + i--);
+	}
+
+	return keys;
+}
+
+bool Table::parseAggregate(const string& item, Aggregate& aggregate) const
+{
+	size_t open = item.find('(');
+	if (open == string::npos)
+		return false;
+
+	if (item.back() != ')')
+		throw std::invalid_argument("Invalid aggregate!");
+
+	string func = item.substr(0, open);
+	string col = item.substr(open + 1, item.size() - open - 2);
+
+	if (func == "COUNT")
+		aggregate.func = AggregateFunc::Count;
+	else if (func == "SUM")
+		aggregate.func = AggregateFunc::Sum;
+	else if (func == "AVG")
+		aggregate.func = AggregateFunc::Avg;
+	else if (func == "MIN")
+		aggregate.func = AggregateFunc::Min;
+	else if (func == "MAX")
+		aggregate.func = AggregateFunc::Max;
+	else
+		throw std::invalid_argument("Invalid aggregate!");
+
+	if (col == "*")
+	{
+		if (aggregate.func != AggregateFunc::Count)
+			throw std::invalid_argument("Only COUNT can be used with *!");
+
+		aggregate.colInd = COUNT_ALL;
+		return true;
+	}
+
+	if (colNameIndexHT.find(col) == colNameIndexHT.end())
+		throw std::invalid_argument("Column doesn't exist in the table!");
+
+	aggregate.colInd = colNameIndexHT.at(col);
+	if ((aggregate.func == AggregateFunc::Sum || aggregate.func == AggregateFunc::Avg)
+		&& colTypes[aggregate.colInd] != "Int" && colTypes[aggregate.colInd] != "Double")
+		throw std::invalid_argument("SUM and AVG can be used only with Int and Double columns!");
+
+	return true;
+}
+
+unique_ptr<Operator> Table::scanPlan(const vector<string>& indexedExpr, const RowBitmap& rows, const Predicate& condition) const
+{
+	unique_ptr<Operator> plan;
+	if (!indexedExpr.empty())
+		plan = std::make_unique<IndexFetch>(name, rows.toRecordPtrs());
+	else
+	{
+		// a page isn't read if its zone map shows that none of its rows can match
+		plan = std::make_unique<TableScan>(name, currPageNumber,
+			[this, condition](size_t pageNum) { return !condition.mayMatch(zoneMaps[pageNum - 1]); });
+	}
+
+	if (!condition.isEmpty())
+	{
+		plan = std::make_unique<Filter>(std::move(plan),
+			[condition](const Record& record) { return condition.matches(record); });
+	}
+
+	return plan;
+}
+
+IndexBounds Table::indexBounds(const vector<string>& indexedExpr, const string& col) const
+{
+	IndexBounds bounds;
+	size_t depth = 0;
+	bool negated = false;
+
+	// only the comparisons joined with AND outside of the brackets hold for every selected row
+	for (size_t i = 0; i < indexedExpr.size(); i++)
+	{
+		if (indexedExpr[i] == "(")
+			depth++;
+		else if (indexedExpr[i] == ")")
+			depth--;
+		else if (indexedExpr[i] == "OR" && depth == 0)
+			return IndexBounds();
+
+		// a NOT before a comparison or a bracket turns it around
+		if (isLogicalOpOrBracket(indexedExpr[i]) || i + 2 >= indexedExpr.size())
+		{
+			negated = indexedExpr[i] == "NOT" && depth == 0;
+			continue;
+		}
+
+		const string& oper = indexedExpr[i + 1];
+		if (depth == 0 && !negated && indexedExpr[i] == col)
+		{
+			Data bound = parseBound(col, indexedExpr[i + 2]);
+			if ((oper == ">" || oper == ">=" || oper == "==") && (bounds.from.isNull() || bound > bounds.from))
+				bounds.from = bound;
+			if ((oper == "<" || oper == "<=" || oper == "==") && (bounds.to.isNull() || bound < bounds.to))
+				bounds.to = bound;
+		}
+
+		negated = false;
+		i += 2;
+	}
+
+	return bounds;
+}
+
+bool Table::useIndexOnly(const RowBitmap& rows, const vector<IndexBounds>& bounds, size_t limit) const
+{
+	// the values of one column are given as they are walked, so a LIMIT stops the walk
+	if (bounds.size() == 1)
+		return cheapWalk(rows, bounds[0], limit);
+
+	for (size_t i = 0; i < bounds.size(); i++)
+	{
+		if (!cheapWalk(rows, bounds[i], NO_LIMIT))
+			return false;
+	}
+
+	// the values of more columns are kept until all walks end, so a LIMIT can't stop them
+	return limit == NO_LIMIT && rows.size() * bounds.size() * sizeof(Data) <= Sort::getMemoryBudget();
+}
+
+bool Table::cheapWalk(const RowBitmap& rows, const IndexBounds& bounds, size_t limit) const
+{
+	// a walk between bounds reads about the leaves of the conditions on its column
+	if (!bounds.from.isNull() || !bounds.to.isNull())
+		return true;
+
+	// a walk of a whole index reads a leaf for every row of the table,
+	// a LIMIT stops it after about limit * (live rows / selected rows) leaves
+	size_t leaves = liveRows.size();
+	if (limit < leaves && rows.size() > 0)
+		leaves = std::min(leaves, limit * ((liveRows.size() + rows.size() - 1) / rows.size()));
+
+	return leaves <= rows.size() * INDEX_ONLY_MIN_SHARE;
+}
+
+void Table::remove(const string& expression)
+{
+	if (indexedColsRecordsHT.at(indexedCols[0]).isEmpty())
+		return;
+
+	vector<string> indexedExpr;
+	vector<string> residualExpr;
+	splitConjuncts(parseExpression(expression), indexedExpr, residualExpr);
+	Predicate condition = compileCondition(residualExpr);
+
+	// both give the rows ordered by page, so every page is visited once
+	vector<RecordPtr> recordPtrs = indexedExpr.empty() ? liveRows.toRecordPtrs() : getIntervals(indexedExpr);
+
+	for (size_t i = 0; i < recordPtrs.size(); i++)
+	{
+		size_t pageNum = recordPtrs[i].pageNumber();
+		if (!condition.mayMatch(zoneMaps[pageNum - 1]))
+		{
+			while (i + 1 < recordPtrs.size() && recordPtrs[i + 1].pageNumber() == pageNum)
+				i++;
+			continue;
+		}
+
+		Page& page = BufferPool::i().getPage(name, pageNum);
+		bool modified = false;
+
+		// go through all of the selected records in the current page
+		for (; i < recordPtrs.size() && recordPtrs[i].pageNumber() == pageNum; i++)
+		{
+			RecordPtr recPtr = recordPtrs[i];
+			Record record = page.getRecord(recPtr.rowNumber());
+			if (!record.isEmpty() && condition.matches(record))
+			{
+				for (size_t k = 0; k < indexedCols.size(); k++)
+				{
+					indexedColsRecordsHT[indexedCols[k]]
+						.remove({ record.getColData(colNameIndexHT[indexedCols[k]]), recPtr });
+				}
+				page.removeRecord(recPtr.rowNumber());
+				liveRows.remove(recPtr);
+				bytes -= record.getBytes();
+				modified = true;
+			}
+		}
+		i--;
+
+		if (modified)
+		{
+			BufferPool::i().markDirty(name, pageNum);
+			updateZoneMap(pageNum, page);
+			freeSpaceMap.update(pageNum, page.availableSpace());
+		}
+	}
+}
+
+void Table::createIndex(const string& indexCol)
+{
+	if (colNameIndexHT.find(indexCol) == colNameIndexHT.end())
+		throw std::invalid_argument("Column doesn't exist!");
+
+	if (indexedColsRecordsHT.find(indexCol) != indexedColsRecordsHT.end())
+		throw std::invalid_argument("This column already has an index!");
+
+	vector<RecordPtr> recordPtrs = liveRows.toRecordPtrs();
+	vector<Record> records;
+	transformToRecords(recordPtrs, records);
+
+	vector<BPlusTree::Kvp> elements;
+	elements.reserve(records.size());
+	for (size_t i = 0; i < records.size(); i++)
+		elements.push_back({ records[i].getColData(colNameIndexHT.at(indexCol)), recordPtrs[i] });
+
+	BPlusTree index;
+	index.bulkLoad(std::move(elements));
+
+	indexedCols.push_back(indexCol);
+	indexedColsRecordsHT[indexCol] = std::move(index);
+}
+
+void Table::vacuum(const string& clusterCol)
+{
+	const string& col = clusterCol.empty() ? indexedCols[0] : clusterCol;
+	if (colNameIndexHT.find(col) == colNameIndexHT.end())
+		throw std::invalid_argument("Column doesn't exist!");
+
+	if (indexedColsRecordsHT.find(col) == indexedColsRecordsHT.end())
+		throw std::invalid_argument("The table can be ordered only by an indexed column!");
+
+	// the rows are written in the order of the index to the pages of a new segment,
+	// which replaces the old one only after it is complete
+	Table vacuumed;
+	vacuumed.name = name + "_vacuum";
+	vacuumed.pageSize = pageSize;
+	vacuumed.colNames = colNames;
+	vacuumed.colTypes = colTypes;
+	vacuumed.indexedCols = indexedCols;
+	vacuumed.colNameIndexHT = colNameIndexHT;
+	vacuumed.bloomBitsPerKey = bloomBitsPerKey;
+	for (const string& indexedCol : indexedCols)
+		vacuumed.indexedColsRecordsHT[indexedCol] = BPlusTree();
+
+	// the new segment and the temporary table file are deleted if the vacuum fails before the switch,
+	// so the old table stays as it was
+	const string segment = vacuumed.name;
+	const string tableFile = name + ".bin";
+	const string tempFile = tableFile + ".tmp";
+	BufferPool::i().createSegment(segment, pageSize);
+	try
+	{
+		vacuumed.createPage();
+
+		// the rows are streamed from the old pages, only a batch of them is kept in memory
+		IndexScan scan(name, indexedColsRecordsHT.at(col), liveRows);
+		vector<Record> batch;
+		batch.reserve(VACUUM_BATCH_SIZE);
+		Record record;
+		while (scan.next(record))
+		{
+			batch.push_back(std::move(record));
+			if (batch.size() == VACUUM_BATCH_SIZE)
+			{
+				vacuumed.insertRecords(batch);
+				batch.clear();
+			}
+		}
+		vacuumed.insertRecords(batch);
+
+		// the new pages are written and the table file is saved next to the old one, which is replaced
+		// only after the new segment is moved over the old one, so a failed move leaves the old table whole
+		BufferPool::i().flush(segment);
+		vacuumed.name = name;
+		vacuumed.serialize(tempFile);
+		BufferPool::i().replaceSegment(name, segment);
+	}
+	catch (...)
+	{
+		BufferPool::i().dropSegment(segment);
+		std::remove(tempFile.c_str());
+		throw;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempFile, tableFile, error);
+	*this = std::move(vacuumed);
+	if (error)
+		throw std::exception("Couldn't replace table file!");
+}
+
+void Table::createBloomFilter(const string& col, size_t bitsPerKey)
+{
+	if (colNameIndexHT.find(col) == colNameIndexHT.end())
+		throw std::invalid_argument("Column doesn't exist!");
+
+	size_t colInd = colNameIndexHT.at(col);
+	if (colTypes[colInd] == "Double")
+		throw std::invalid_argument("Bloom filters can't be used on Double columns!");
+
+	if (bloomBitsPerKey[colInd] > 0)
+		throw std::invalid_argument("This column already has a Bloom filter!");
+
+	if (bitsPerKey == 0 || bitsPerKey > MAX_BLOOM_BITS_PER_KEY)
+		throw std::invalid_argument("Invalid bits per key given!");
+
+	bloomBitsPerKey[colInd] = bitsPerKey;
+
+	// the filters of the existing pages are filled by reading every page once
+	for (size_t i = 1; i <= currPageNumber; i++)
+	{
+		const Page& page = BufferPool::i().getPage(name, i);
+		zoneMaps[i - 1].enableFilter(colInd, i < currPageNumber ? page.size() : estimateRowsPerPage(), bitsPerKey);
+		updateZoneMap(i, page);
+	}
+}
+
+void Table::serialize(const string& fileName) const
+{
+	BufferPool::i().flush(name);
+
+	std::ofstream out(fileName.empty() ? name + ".bin" : fileName, std::ios::binary);
+
+	out.write((const char*)&TABLE_FILE_MARK, sizeof(TABLE_FILE_MARK));
+	out.write((const char*)&TABLE_FILE_VERSION, sizeof(TABLE_FILE_VERSION));
+
+	size_t len = name.length();
+	out.write((const char*)&len, sizeof(len));
+	out.write((const char*)&name[0], len);
+
+	out.write((const char*)&currPageNumber, sizeof(currPageNumber));
+	out.write((const char*)&bytes, sizeof(bytes));
+	out.write((const char*)&pageSize, sizeof(pageSize));
+
+	len = colNames.size();
+	out.write((const char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size = colNames[i].length();
+		out.write((const char*)&size, sizeof(size));
+		out.write((const char*)&colNames[i][0], size);
+	}
+
+	len = colTypes.size();
+	out.write((const char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size = colTypes[i].length();
+		out.write((const char*)&size, sizeof(size));
+		out.write((const char*)&colTypes[i][0], size);
+	}
+
+	len = indexedCols.size();
+	out.write((const char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+	{
+		size_t size = indexedCols[i].length();
+		out.write((const char*)&size, sizeof(size));
+		out.write((const char*)&indexedCols[i][0], size);
+	}
+
+	len = colNameIndexHT.size();
+	out.write((const char*)&len, sizeof(len));
+	for (const pair<string, size_t>& p : colNameIndexHT)
+	{
+		size_t size = p.first.length();
+		out.write((const char*)&size, sizeof(size));
+		out.write((const char*)&p.first[0], size);
+
+		out.write((const char*)&p.second, sizeof(p.second));
+	}
+
+	len = indexedColsRecordsHT.size();
+	out.write((const char*)&len, sizeof(len));
+	for (const pair<string, BPlusTree>& p : indexedColsRecordsHT)
+	{
+		size_t size = p.first.length();
+		out.write((const char*)&size, sizeof(size));
+		out.write((const char*)&p.first[0], size);
+
+		p.second.serialize(out);
+	}
+
+	out.write((const char*)&bloomBitsPerKey[0], bloomBitsPerKey.size() * sizeof(size_t));
+
+	len = zoneMaps.size();
+	out.write((const char*)&len, sizeof(len));
+	for (size_t i = 0; i < len; i++)
+		zoneMaps[i].serialize(out);
+
+	freeSpaceMap.serialize(out);
+
+	out.close();
+}
+
+string Table::getHeaderInfo() const
+{
+	string res;
+
+	res.push_back('(');
+
+	for (size_t i = 0; i < colNames.size(); i++)
+	{
+		res += colNames[i];
+		res.push_back(':');
+		res += colTypes[i];
+
+		for (size_t j = 0; j < indexedCols.size(); j++)
+		{
+			if (colNames[i] == indexedCols[j])
+			{
+				res += ", ";
+				res += "Indexed";
+			}
+		}
+
+		if (bloomBitsPerKey[i] > 0)
+			res += ", Bloom filter";
+
+		if (i != colNames.size() - 1) res += "; ";
+	}
+
+	res.push_back(')');
+
+	return res;
+}
+
+vector<string> Table::getColsNamesToPrint(const string& toPrint) const
+{
+	vector<string> result;
+
+	if (toPrint == "*")
+	{
+		return colNames;
+	}
+	else
+		result = parseColsToPrint(toPrint);
+
+	return result;
+}
+
+Page& Table::createPage()
+{
+	currPageNumber++;
+	size_t rows = estimateRowsPerPage();
+	zoneMaps.push_back(ZoneMap(colNames.size()));
+	for (size_t i = 0; i < colNames.size(); i++)
+	{
+		if (bloomBitsPerKey[i] > 0)
+			zoneMaps.back().enableFilter(i, rows, bloomBitsPerKey[i]);
+	}
+
+	Page& page = BufferPool::i().putPage(name, currPageNumber, Page(0, pageSize, columnTypes()));
+	freeSpaceMap.update(currPageNumber, page.availableSpace());
+
+	return page;
+}
+
+size_t Table::estimateRowsPerPage() const
+{
+	// the rows of a table have similar sizes, so a new page gets about as many rows as the last full one
+	if (currPageNumber >= 2)
+	{
+		const ZoneMap& last = zoneMaps[currPageNumber - 2];
+		if (last.getLiveRows() + last.getRemovedRows() > 0)
+			return last.getLiveRows() + last.getRemovedRows();
+	}
+
+	return pageSize / (sizeof(size_t) * (colNames.size() + 1));
+}
+
+void Table::updateZoneMap(size_t pageNum, const Page& page)
+{
+	ZoneMap& zone = zoneMaps[pageNum - 1];
+	zone.clear();
+
+	for (size_t i = 0; i < page.size(); i++)
+	{
+		Record record = page.getRecord(i);
+		if (record.isEmpty())
+			zone.addRemoved();
+		else
+			zone.add(record);
+	}
+}
+
+vector<DataType> Table::columnTypes() const
+{
+	vector<DataType> types;
+	types.reserve(colTypes.size());
+	for (size_t i = 0; i < colTypes.size(); i++)
+		types.push_back(Data::typeFromName(colTypes[i]));
+
+	return types;
+}
+
+void Table::setCollections(const string& header)
+{
+	string currColName;
+	string currColType;
+
+	bool buildColName = true;
+	bool buildColType = false;
+
+	// header example: (ID:Int, Name:String, Value:Int)
+
+	size_t ind = 0;
+
+	for (size_t i = 1; i < header.size() - 1; i++)
+	{
+		if (header[i] == ' ')
+			continue;
+		else if (header[i] == ':' || header[i] == ',')
+		{
+			if (header[i] == ',')
+			{
+				colNames.push_back(currColName);
+				colTypes.push_back(currColType);
+				colNameIndexHT[currColName] = ind++;
+
+				currColName.clear();
+				currColType.clear();
+			}
+
+			buildColName = !buildColName;
+			buildColType = !buildColType;
+			continue;
+		}
+
+		if (buildColName)
+			currColName += header[i];
+		else if (buildColType)
+			currColType += header[i];
+	}
+
+	colNames.push_back(currColName);
+	colTypes.push_back(currColType);
+	colNameIndexHT[currColName] = ind++;
+}
+
+Record Table::toRecord(const string& str) const
+{
+	Record res;
+
+	size_t ind = 0;
+	string currData;
+	bool readingString = false;
+
+	// str example: (1, "Test", 10)
+
+	for (size_t i = 0; i < str.size(); i++)
+	{
+		if (str[i] == '\"')
+			readingString = !readingString;
+
+		if (readingString)
+		{
+			currData += str[i];
+			continue;
+		}
+
+		if (str[i] == '(' || str[i] == ' ')
+			continue;
+
+		if (str[i] == ',' || str[i] == ')')
+		{
+			if (isInteger(currData))
+			{
+				if (colTypes[ind] != "Int")
+					throw std::invalid_argument("Invalid row given!");
+				Data d(std::stoi(currData));
+				res.addColumn(d);
+			}
+			else if (isDouble(currData))
+			{
+				if (colTypes[ind] != "Double")
+					throw std::invalid_argument("Invalid row given!");
+				Data d(std::stod(currData));
+				res.addColumn(d);
+			}
+			else if (isString(currData))
+			{
+				if (colTypes[ind] != "String")
+					throw std::invalid_argument("Invalid row given!");
+				Data d(currData);
+				res.addColumn(d);
+			}
+			else if (isDateTime(currData))
+			{
+				if (colTypes[ind] != "DateTime")
+					throw std::invalid_argument("Invalid row given!");
+				Data d(currData);
+				res.addColumn(d);
+			}
+			else
+				throw std::invalid_argument("Invalid row given!");
+			ind++;
+			currData.clear();
+		}
+		else
+			currData += str[i];
+	}
+
+	return res;
+}
+
+bool Table::isInteger(const string& data) const
+{
+	size_t i = 0;
+	if (data[i] == '-')
+	{
+		i++;
+		if (i == data.size()) return false;
+	}
+	for (i; i < data.size(); i++)
+		if (!isNumber(data[i])) return false;
+
+	return true;
+}
+
+bool Table::isDouble(const string& data) const
+{
+	size_t i = 0;
+	if (data[i] == '-')
+	{
+		i++;
+		if (i == data.size()) return false;
+	}
+	size_t dotsCnt = 0;
+	for (i; i < data.size(); i++)
+	{
+		if (data[i] == '.')
+			dotsCnt++;
+		else
+			if (!isNumber(data[i]))
+				return false;
+	}
+	if (dotsCnt != 1)
+		return false;
+
+	return true;
+}
+
+bool Table::isString(const string& data) const
+{
+	return data[0] == '\"' && data[data.size() - 1] == '\"';
+}
+
+bool Table::isDateTime(const std::string& str) const
+{
+	std::string day, month, year;
+
+	if (str.size() < 5)
+		return false;
+
+	size_t pipes = 0;
+	for (size_t i = 0; i < str.size(); i++)
+	{
+		if (str[i] == '-')
+			pipes++;
+	}
+	if (pipes != 2)
+		return false;
+
+	size_t ind = 0;
+
+	while (ind < str.size() && str[ind] != '-')
+	{
+		day += str[ind];
+		ind++;
+	}
+	ind++;
+
+	if (day.size() < 1 || day.size() > 2)
+		return false;
+
+	while (ind < str.size() && str[ind] != '-')
+	{
+		month += str[ind];
+		ind++;
+	}
+	ind++;
+
+	if (month.size() < 1 || month.size() > 2)
+		return false;
+
+	while (ind < str.size())
+	{
+		year += str[ind];
+		ind++;
+	}
+
+	if (year.size() < 1 || year.size() > 4)
+		return false;
+
+	return true;
+}
+
+vector<string> Table::parseExpression(const string& expression) const
+{
+	vector<string> res;
+	string currWord;
+
+	for (size_t i = 0; i < expression.size(); i++)
+	{
+		if (expression[i] == '(')
+		{
+			res.push_back("(");
+			continue;
+		}
+
+		if (expression[i] != ' ' && expression[i] != ')')
+		{
+			currWord += expression[i];
+		}
+
+		if ((expression[i] == ' ' || expression[i] == ')' || i == (expression.size() - 1)) && !currWord.empty())
+		{
+			res.push_back(currWord);
+			currWord.clear();
+		}
+
+		if (expression[i] == ')')
+		{
+			res.push_back(")");
+			continue;
+		}
+	}
+
+	return res;
+}
+
+bool Table::containsOnlyIndexedCols(const vector<string>& arr) const
+{
+	if (arr.size() == 0)
+		return false;
+
+	for (size_t i = 0; i < arr.size(); i++)
+	{
+		if (arr[i] == "AND" || arr[i] == "OR" || arr[i] == "NOT"
+			|| arr[i] == "<" || arr[i] == ">" || arr[i] == "<="
+			|| arr[i] == ">=" || arr[i] == "!=" || arr[i] == "==")
+			continue;
+
+		bool isColName = false;
+		bool isIndexedCol = false;
+
+		for (size_t j = 0; j < colNames.size(); j++)
+		{
+			if (arr[i] == colNames[j])
+			{
+				isColName = true;
+				break;
+			}
+		}
+
+		if (isColName)
+		{
+			for (size_t j = 0; j < indexedCols.size(); j++)
+			{
+				if (arr[i] == indexedCols[j])
+				{
+					isIndexedCol = true;
+					break;
+				}
+			}
+			if (!isIndexedCol) return false;
+		}
+	}
+	return true;
+}
+
+void Table::splitConjuncts(const vector<string>& expressionArr, vector<string>& indexed, vector<string>& residual) const
+{
+	size_t begin = 0;
+	size_t end = expressionArr.size();
+
+	// brackets around the whole expression are dropped, so their ANDs are on the top level
+	while (end - begin >= 2 && expressionArr[begin] == "(" && expressionArr[end - 1] == ")")
+	{
+		size_t depth = 0;
+		size_t closing = begin;
+		for (; closing < end; closing++)
+		{
+			if (expressionArr[closing] == "(")
+				depth++;
+			else if (expressionArr[closing] == ")" && --depth == 0)
+				break;
+		}
+
+		if (closing != end - 1)
+			break;
+
+		begin++;
+		end--;
+	}
+
+	vector<vector<string>> conjuncts(1);
+	size_t depth = 0;
+
+	for (size_t i = begin; i < end; i++)
+	{
+		if (expressionArr[i] == "(")
+			depth++;
+		else if (expressionArr[i] == ")" && depth > 0)
+			depth--;
+
+		if (depth == 0 && expressionArr[i] == "OR")
+		{
+			// OR binds weaker than AND, so the expression can't be split
+			if (containsOnlyIndexedCols(expressionArr))
+				indexed = expressionArr;
+			else
+				residual = expressionArr;
+			return;
+		}
+
+		if (depth == 0 && expressionArr[i] == "AND")
+			conjuncts.emplace_back();
+		else
+			conjuncts.back().push_back(expressionArr[i]);
+	}
+
+	for (size_t i = 0; i < conjuncts.size(); i++)
+	{
+		if (conjuncts[i].empty())
+		{
+			if (conjuncts.size() > 1)
+				throw std::exception("Invalid expression!");
+			continue;
+		}
+
+		vector<string>& part = containsOnlyIndexedCols(conjuncts[i]) ? indexed : residual;
+		if (!part.empty())
+			part.push_back("AND");
+		part.insert(part.end(), conjuncts[i].begin(), conjuncts[i].end());
+	}
+}
+
+Predicate Table::compileCondition(const vector<string>& expression) const
+{
+	Predicate predicate;
+	stack<string> evaluationStack;
+
+	// shunting yard - the comparisons and the logical operations are added to the predicate in postfix order
+	for (size_t i = 0; i < expression.size(); i++)
+	{
+		if (isLogicalOpOrBracket(expression[i]))
+		{
+			if (expression[i] == "(")
+			{
+				evaluationStack.push(expression[i]);
+			}
+			else if (expression[i] == ")")
+			{
+				if (evaluationStack.empty())
+					throw std::exception("Invalid expression!");
+
+				while (evaluationStack.top() != "(")
+				{
+					if (evaluationStack.top() == "AND" || evaluationStack.top() == "OR" || evaluationStack.top() == "NOT")
+						predicate.pushLogical(toLogicalOp(evaluationStack.top()));
+
+					evaluationStack.pop();
+				}
+				evaluationStack.pop();
+			}
+			else if (expression[i] == "AND" || expression[i] == "OR" || expression[i] == "NOT")
+			{
+				while (!evaluationStack.empty() && precedence(evaluationStack.top()) > precedence(expression[i]))
+				{
+					predicate.pushLogical(toLogicalOp(evaluationStack.top()));
+					evaluationStack.pop();
+				}
+
+				evaluationStack.push(expression[i]);
+			}
+		}
+		else
+		{
+			if (i + 2 >= expression.size())
+				throw std::exception("Invalid expression!");
+
+			string colName = expression[i];
+			if (colNameIndexHT.find(colName) == colNameIndexHT.end())
+				throw std::exception("Given column doesn't exist!");
+
+			string type = checkRightType(expression[i + 2]);
+			Data value;
+			if (type == "")
+			{
+				throw std::exception("Invalid type!");
+			}
+			else if (type == "Int")
+			{
+				value.setValue(std::stoi(expression[i + 2]));
+			}
+			else if (type == "Double")
+			{
+				value.setValue(std::stod(expression[i + 2]));
+			}
+			else
+			{
+				value.setValue(expression[i + 2]);
+			}
+
+			// the value is converted to the type of the column here instead of in every comparison
+			size_t colInd = colNameIndexHT.at(colName);
+			predicate.pushComparison(colInd, Predicate::toOp(expression[i + 1]), value.convertTo(Data::typeFromName(colTypes[colInd])));
+
+			i += 2;
+		}
+	}
+
+	while (!evaluationStack.empty())
+	{
+		if (evaluationStack.top() != "(")
+			predicate.pushLogical(toLogicalOp(evaluationStack.top()));
+		evaluationStack.pop();
+	}
+
+	if (!expression.empty() && !predicate.isComplete())
+		throw std::exception("Invalid expression!");
+
+	return predicate;
+}
+
+Predicate::Op Table::toLogicalOp(const string& oper) const
+{
+	if (oper == "AND")
+		return Predicate::Op::And;
+	else if (oper == "OR")
+		return Predicate::Op::Or;
+
+	return Predicate::Op::Not;
+}
+
+size_t Table::precedence(const string& arg) const
+{
+	if (arg == "NOT")
+		return 3;
+	else if (arg == "AND")
+		return 2;
+	else if (arg == "OR")
+		return 1;
+
+	return 0;
+}
+
+string Table::checkRightType(const string& data) const
+{
+	if (isInteger(data))
+	{
+		return "Int";
+	}
+	else if (isDouble(data))
+	{
+		return "Double";
+	}
+	else if (isString(data))
+	{
+		return "String";
+	}
+	else if (isDateTime(data))
+	{
+		return "DateTime";
+	}
+
+	return "";
+}
+
+vector<RecordPtr> Table::getIntervals(const vector<string>& expressionArr) const
+{
+	stack<string> evaluationStack;
+	queue<string> postfixQueue;
+
+	// constructing the intervals and turning into postfix expression
+	for (size_t i = 0; i < expressionArr.size(); i++)
+	{
+		if (isLogicalOpOrBracket(expressionArr[i]))
+		{
+			if (expressionArr[i] == "(")
+			{
+				evaluationStack.push(expressionArr[i]);
+			}
+			else if (expressionArr[i] == ")")
+			{
+				if (evaluationStack.empty())
+					throw std::exception("Invalid expression!");
+
+				while (evaluationStack.top() != "(")
+				{
+					if (evaluationStack.top() == "AND" || evaluationStack.top() == "OR" || evaluationStack.top() == "NOT")
+						postfixQueue.push(evaluationStack.top());
+
+					evaluationStack.pop();
+				}
+				evaluationStack.pop();
+			}
+			else if (expressionArr[i] == "AND" || expressionArr[i] == "OR" || expressionArr[i] == "NOT")
+			{
+				while (!evaluationStack.empty() && precedence(evaluationStack.top()) > precedence(expressionArr[i]))
+				{
+					postfixQueue.push(evaluationStack.top());
+					evaluationStack.pop();
+				}
+
+				evaluationStack.push(expressionArr[i]);
+			}
+		}
+		else
+		{
+			if (i + 2 >= expressionArr.size())
+				throw std::exception("Invalid expression!");
+
+			string colName = expressionArr[i];
+			string oper = expressionArr[i + 1];
+			string type = colTypes[colNameIndexHT.at(colName)];
+			Data bound = parseBound(colName, expressionArr[i + 2]);
+
+			if (oper == "!=")
+			{
+				Data temp = bound;
+				Interval interval1 = buildInterval(colName, bound, "<", type);
+				Interval interval2 = buildInterval(colName, temp, ">", type);
+				postfixQueue.push(interval1.toString());
+				postfixQueue.push(interval2.toString());
+				postfixQueue.push("OR");
+			}
+			else
+			{
+				Interval interval = buildInterval(colName, bound, oper, type);
+				postfixQueue.push(interval.toString());
+			}
+
+
+			i += 2;
+		}
+	}
+
+	while (!evaluationStack.empty())
+	{
+		postfixQueue.push(evaluationStack.top());
+		evaluationStack.pop();
+	}
+
+	stack<RowBitmap> resultStack;
+
+	// getting the result
+	while (!postfixQueue.empty())
+	{
+		if (postfixQueue.front() != "AND" && postfixQueue.front() != "OR" && postfixQueue.front() != "NOT")
+		{
+			Interval interval(postfixQueue.front());
+			RowBitmap rows;
+			if (!interval.isEmpty())
+			{
+				rows = RowBitmap(indexedColsRecordsHT.at(interval.getColName())
+					.getElementsInRange(interval.getLeftBound(), interval.getRightBound()));
+			}
+			resultStack.push(std::move(rows));
+			postfixQueue.pop();
+		}
+		else if (postfixQueue.front() == "AND" || postfixQueue.front() == "OR")
+		{
+			if (resultStack.size() < 2)
+				throw std::exception("Not enough arguments for binary expression!");
+
+			RowBitmap first = std::move(resultStack.top());
+			resultStack.pop();
+
+			if (postfixQueue.front() == "AND")
+				resultStack.top() &= first;
+			else
+				resultStack.top() |= first;
+
+			postfixQueue.pop();
+		}
+		else if (postfixQueue.front() == "NOT")
+		{
+			if (resultStack.empty())
+				throw std::exception("Not enough arguments for unary expression!");
+
+			// the complement is every live row that isn't in the set
+			RowBitmap complement = liveRows;
+			complement -= resultStack.top();
+			resultStack.top() = std::move(complement);
+
+			postfixQueue.pop();
+		}
+	}
+
+	if (resultStack.size() != 1)
+		throw std::exception("Invalid expression!");
+
+	return resultStack.top().toRecordPtrs();
+}
+
+Data Table::parseBound(const string& colName, const string& value) const
+{
+	string type = checkRightType(value);
+	Data bound;
+	if (type == "")
+	{
+		throw std::exception("Invalid type!");
+	}
+	else if (type == "Int")
+	{
+		bound.setValue(std::stoi(value));
+	}
+	else if (type == "Double")
+	{
+		bound.setValue(std::stod(value));
+	}
+	else if (type == "String")
+	{
+		bound.setValue(value);
+	}
+	else if (type == "DateTime")
+	{
+		bound.setValue(value);
+	}
+
+	// the bounds are kept in the type of the column, like the keys of its index
+	return bound.convertTo(Data::typeFromName(colTypes[colNameIndexHT.at(colName)]));
+}
+
+Interval Table::buildInterval(const string& colName, Data& bound, const string& oper, const string& type) const
+{
+	if (oper == ">")
+	{
+		Data rightBound = indexedColsRecordsHT.at(colName).max();
+		bound = indexedColsRecordsHT.at(colName).getNextGreaterThan(bound);
+		if (bound.isNull())
+		{
+			return Interval(rightBound, rightBound, colName, type, true);
+		}
+		Interval interval(bound, rightBound, colName, type, false);
+		return interval;
+	}
+	else if (oper == ">=")
+	{
+		if (bound < indexedColsRecordsHT.at(colName).min())
+		{
+			return Interval(bound, bound, colName, type, true);
+		}
+		Data rightBound = indexedColsRecordsHT.at(colName).max();
+		Interval interval(bound, rightBound, colName, type, false);
+		return interval;
+	}
+	else if (oper == "<")
+	{
+		Data leftBound = indexedColsRecordsHT.at(colName).min();
+		bound = indexedColsRecordsHT.at(colName).getPrevLesserThan(bound);
+		if (bound.isNull())
+		{
+			return Interval(leftBound, leftBound, colName, type, true);
+		}
+		Interval interval(leftBound, bound, colName, type, false);
+		return interval;
+	}
+	else if (oper == "<=")
+	{
+		if (bound > indexedColsRecordsHT.at(colName).max())
+		{
+			return Interval(bound, bound, colName, type, true);
+		}
+		Data leftBound = indexedColsRecordsHT.at(colName).min();
+		Interval interval(leftBound, bound, colName, type, false);
+		return interval;
+	}
+	else if (oper == "==")
+	{
+		if (bound.isNull())
+		{
+			return Interval(Data(), Data(), colName, type, true);
+		}
+		return Interval(bound, bound, colName, type, false);
+	}
+	else
+		throw std::invalid_argument("Invalid operation given!");
+}
+
+void Table::transformToRecords(const vector<RecordPtr>& recordPtrs, vector<Record>& records) const
+{
+	for (size_t i = 0; i < recordPtrs.size(); i++)
+	{
+		size_t pageNum = recordPtrs[i].pageNumber();
+		Page& page = BufferPool::i().getPage(name, pageNum);
+
+		for (; i < recordPtrs.size() && recordPtrs[i].pageNumber() == pageNum; i++)
+			records.push_back(page.getRecord(recordPtrs[i].rowNumber()));
+		i--;
+	}
+}
+
+vector<string> Table::parseColsToPrint(const string& toPrint) const
+{
+	vector<string> res;
+	string currCol;
+
+	// the columns are separated by spaces or commas
+	for (size_t i = 0; i < toPrint.size(); i++)
+	{
+		if (toPrint[i] != ' ' && toPrint[i] != ',')
+			currCol += toPrint[i];
+		else if (!currCol.empty())
+		{
+			res.push_back(currCol);
+			currCol.clear();
+		}
+	}
+
+	if (!currCol.empty())
+		res.push_back(currCol);
+
+	return res;
+}
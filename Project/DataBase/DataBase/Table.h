@@ -1,239 +1,308 @@
-#pragma once
-#include "BPlusTree.h"
-#include "Page.h"
-#include "Interval.h"
-#include <string>
-#include <unordered_map>
-#include <stack>
-#include <queue>
-#include <forward_list>
-
-using std::string;
-using std::unordered_map;
-using std::stack;
-using std::queue;
-using std::forward_list;
-using std::swap;
-
-/// @brief Class for a table in the database
-
-class Table
-{
-public:
-	Table();
-	Table(const string& header, const string& name, const string& firstIndexedCol);
-	Table(std::ifstream& in);
-
-	/// @brief Insert a row in the table
-	/// @param recordStr - the record that will be inserted in a string format
-	void insert(const vector<string>& recordStr);
-
-	/// @brief Filters records of the table by given criteria
-	/// @param expression - the WHERE expression
-	/// @param orderByWhat - the columns that will be shown on the console
-	/// @param distinct - boolean that shows if same records in toPrint will be printed on the console or not
-	/// @param toPrint - the columns that will be shown on the console
-	/// @return vector rows in string format 
-	vector<string> select(const string& expression, const string& orderByWhat, bool distinct, const string& toPrint) const;
-
-	/// @brief Removes records from the table by given criteria
-	/// @param expression - the criteria expression in string format
-	void remove(const string& expression);
-
-	/// @brief Creates an index on a given column for faster searching in this column
-	/// @param indexCol - the column to be indexed
-	void createIndex(const string& indexCol);
-
-	/// @brief Gets the ammount of the rows in the table
-	/// @return the size of the first column
-	size_t size() const 
-	{ 
-		if (indexedColsRecordsHT.empty()) return 0;
-		return indexedColsRecordsHT.at(indexedCols[0]).getSize();
-	};
-
-	/// @brief Saves the table to a file with name - the name of the table in binary format
-	void serialize() const;
-
-	/// @brief Gets the header of the table (columns, indexed columns etc.)
-	/// @return the header in string format
-	string getHeaderInfo() const;
-
-	/// @brief Gives the columns that will be printed in the search method
-	/// @param toPrint - columns to be printed
-	/// @return vector of column names to be printed
-	vector<string> getColsNamesToPrint(const string& toPrint) const;
-
-	/// @brief Gets the size of the table
-	/// @return the size in bytes
-	inline unsigned int getBytes() const { return bytes; }
-
-private:
-	/// @brief Creates a Page (new file with name - <name_of_table>_page<currPageNumber>)
-	/// @return the newly created page
-	Page createPage();
-
-	/// @brief Initializes some of the data structures used in the table
-	/// @param header - header of the table
-	void setCollections(const string& header);
-
-	/// @brief Converts a string to a Record
-	/// @param str - string to be converted
-	/// @return the Record converted from the string
-	Record toRecord(const string& str) const;
-
-	inline bool isNumber(const char c) const { return c >= '0' && c <= '9'; };
-
-	/// @brief Checks if a string is an Integer object
-	/// @param data - the string to be checked
-	/// @return true if the string is Integer and false otherwise
-	bool isInteger(const string& data) const;
-
-	/// @brief Checks if a string is a Double object
-	/// @param data - the string to be checked
-	/// @return true if the string is Double and false otherwise
-	bool isDouble(const string& data) const;
-
-	/// @brief Checks if a string is a String object
-	/// @param data - the string to be checked
-	/// @return true if the string is String and false otherwise
-	bool isString(const string& data) const;
-
-	/// @brief Checks if a string is a DateTime object
-	/// @param data - the string to be checked
-	/// @return true if the string is DateTime and false otherwise
-	bool isDateTime(const std::string& str) const;
-
-	/// @brief Parses an expression from the search method
-	/// @param expression - the expression to be parsed
-	/// @return a vector of strings of the parsed expression
-	vector<string> parseExpression(const string& expression) const;
-
-	/// @brief Checks if a vector of strings contains only the names of the indexed columns
-	/// @param arr - the vector
-	/// @return true if the vec contains only the names of the indexed columns and false otherwise
-	bool containsOnlyIndexedCols(const vector<string>& arr) const;
-
-	/// @brief Checks if a record satisfies a given search condition
-	/// @param record - the given record
-	/// @param expression - the search expression
-	/// @return true if it satisfies and false otherwise
-	bool checkRecordCondition(const Record& record, const vector<string>& expression) const;
-
-	inline bool isLogicalOpOrBracket(const string& str) const
-	{
-		return str == "(" || str == ")" || str == "AND" || str == "OR" || str == "NOT";
-	}
-
-	/// @brief Gets the precedence of a given logical operation
-	/// @param arg - the logical operation
-	/// @return number depending on the operation
-	size_t precedence(const string& arg) const;
-
-	/// @brief Checks the type of a Data object
-	/// @param data - the Data in a string format
-	/// @return the type of the object in a string format
-	string checkRightType(const string& data) const;
-
-	/// @brief Evaluates the result of 2 booleans and logical operation
-	/// @param first - the first bool in string format
-	/// @param second - the second bool in string format
-	/// @param oper - the operation
-	void evaluateANDOR(const string& first, string& second, const string& oper) const;
-
-	/// @brief Evaluates the result of boolean and not operation
-	/// @param first - the boolean in string format
-	/// @param oper - the operation
-	void evaluateNOT(string& first, const string& oper) const;
-
-	/// @brief Compares two Data objects from the same type
-	/// @param leftArg - the first Data object
-	/// @param oper - the comparative operation
-	/// @param rightArg - the second Data object
-	/// @param record - record to get the one Data from
-	/// @return the result of the evaluation
-	bool evaluate(const string& leftArg, const string& oper, const Data& rightArg, const Record& record) const;
-
-	/// @brief Unites two sets
-	/// @param first - the first set
-	/// @param second - the second set
-	void unite(const set<RecordPtr>& first, set<RecordPtr>& second) const;
-
-	/// @brief Intersects two sets
-	/// @param first - the first set
-	/// @param second - the second set
-	void intersect(const set<RecordPtr>& first, set<RecordPtr>& second) const;
-
-	/// @brief Gets the complement of a set
-	/// @param first - the set
-	/// @param colName - name of a indexed column
-	void complement(set<RecordPtr>& first, const string& colName) const;
-
-	/// @brief Uses shunting yard algorithm with sets, intersection, union and complement
-	/// @param expressionArr - the search expression
-	/// @return - the result set
-	vector<RecordPtr> getIntervals(const vector<string>& expressionArr) const;
-
-	/// @brief Builds an Interval object
-	/// @param colName - the name of the indexed column
-	/// @param bound - one of the bounds of the interval
-	/// @param oper - the comparation operation
-	/// @param type - the type of the Data 
-	/// @return the built Interval object
-	Interval buildInterval(const string& colName, Data& bound, const string& oper, const string& type) const;
-
-	/// @brief Checks if a vector of record pointers is sorted
-	/// @param recordPtrs - the vector
-	/// @return true if the vector is sorted and false otherwise
-	bool areSorted(const vector<RecordPtr>& recordPtrs) const;
-
-	/// @brief Converts a vector of record pointers to vector of records
-	/// @param recordPtrs - the vector of record pointers
-	/// @param records - the vector of records
-	void transformToRecords(vector<RecordPtr>& recordPtrs, vector<Record>& records) const;
-
-	/// @brief Converts a vector of record pointers to vector of records satisfying given search condition
-	/// @param recordPtrs - the vector of record pointers
-	/// @param records - the vector of records
-	/// @param expression - the search or remove expression
-	void checkCondAndTransformToRecords(vector<RecordPtr>& recordPtrs, vector<Record>& records, const vector<string>& expression) const;
-
-	/// @brief Sorts a vector of records using heap sort algorithm
-	/// @param records - records to be sorted
-	/// @param colName - the name of a indexed col
-	void orderBy(vector<Record>& records, const string colName) const;
-	void heapSortRecords(vector<Record>& records, const string colName) const;
-	void heapifyRecords(vector<Record>& records, int size, int i, size_t colInd) const;
-	void heapSortRecordPtrs(vector<RecordPtr>& recordPtrs) const;
-	void heapifyRecordPtrs(vector<RecordPtr>& recordPtrs, int size, int i) const;
-
-	/// @brief Converts a string of columns to a vector of strings
-	/// @param toPrint - the column names in string format
-	/// @return the vector of column names strings
-	vector<string> parseColsToPrint(const string& toPrint) const;
-
-	/// @brief Removes repetitive records using a set
-	/// @param distinctSet - the set of strings
-	/// @param toPrint - columns to be printed in string format
-	/// @param result - the distinct strings in a vector
-	/// @param selected - the selected records from the search operation
-	void makeDistinct(const string& toPrint, vector<string>& result, const vector<Record>& selected) const;
-
-	/// @brief Transfers a vector of records to a vector of strings
-	/// @param toPrint - columns to be printed in string format
-	/// @param result - the result vector of rows in string format
-	/// @param selected - the selected records from the search operation
-	void notDistinct(const string& toPrint, vector<string>& result, const vector<Record>& selected) const;
-
-private:
-	string name;
-	size_t currPageNumber;
-	unsigned int bytes;
-
-	vector<string> colNames; // ID, Name, Date, Value, ...  
-	vector<string> colTypes; // Int, String, Double, ...		
-	vector<string> indexedCols; // ID, ...					
-	unordered_map<string, size_t> colNameIndexHT; // (ID,0), (Name,1), ...
-	unordered_map<string, BPlusTree> indexedColsRecordsHT; // (ID, Tree1), (Name, Tree2), ...
-};
-
+#pragma once
+#include "BPlusTree.h"
+#include "BufferPool.h"
+#include "FreeSpaceMap.h"
+#include "Operator.h"
+#include "Predicate.h"
+#include "Interval.h"
+#include "RowBitmap.h"
+#include <string>
+#include <unordered_map>
+#include <stack>
+#include <queue>
+#include <forward_list>
+
+using std::string;
+using std::unordered_map;
+using std::stack;
+using std::queue;
+using std::forward_list;
+using std::swap;
+
+const size_t TABLE_FILE_MARK = SIZE_MAX; // written in place of the name length, followed by the version
+const uint32_t TABLE_FILE_VERSION = 8;
+const size_t NO_LIMIT = SIZE_MAX; // a select without LIMIT
+const size_t VACUUM_BATCH_SIZE = 1000; // the rows of a vacuum are written to the new pages in batches of this size
+const size_t INDEX_ONLY_MIN_SHARE = 32; // the leaves of an index that can be walked instead of reading one selected row
+
+/// @brief Class for a table in the database
+
+class Table
+{
+public:
+	Table();
+	/// @param header - the columns of the table
+	/// @param name - the name of the table
+	/// @param firstIndexedCol - the first indexed column (the first column if empty)
+	/// @param pageSize - the size of the pages of the table in bytes (4, 8, 16, 32 or 64 KiB)
+	Table(const string& header, const string& name, const string& firstIndexedCol, size_t pageSize = PAGE_SIZE);
+	Table(std::ifstream& in);
+
+	/// @brief Inserts rows in the table. All rows are parsed before any of them is stored
+	/// and every index is updated with one sorted batch.
+	/// @param recordStr - the records that will be inserted in a string format
+	void insert(const vector<string>& recordStr);
+
+	/// @brief Filters records of the table by given criteria. The rows are passed to the sink one by one
+	/// as they come out of the pipeline, without keeping all of them in memory (unless they are sorted).
+	/// @param expression - the WHERE expression
+	/// @param orderByWhat - the columns the rows are ordered by, each one followed by ASC or DESC or not (empty for no order)
+	/// @param distinct - boolean that shows if same records in toPrint will be printed on the console or not
+	/// @param toPrint - the columns that will be shown on the console
+	/// @param sink - called with every selected row in string format
+	/// @param limit - the maximum number of selected rows
+	/// @return the number of selected rows
+	size_t select(const string& expression, const string& orderByWhat, bool distinct, const string& toPrint,
+		const function<void(const string&)>& sink, size_t limit = NO_LIMIT) const;
+
+	/// @brief Computes aggregates (COUNT, SUM, AVG, MIN and MAX) of the rows that satisfy given criteria, for every group
+	/// of rows with the same values of the GROUP BY columns. The groups are built while the rows are read, so only
+	/// the groups are kept in memory. Without criteria and groups, COUNT(*) and COUNT, MIN and MAX of indexed columns
+	/// are taken from the indexes without reading any page.
+	/// @param expression - the WHERE expression
+	/// @param groupBy - the columns the rows are grouped by (empty for one group of all rows)
+	/// @param toPrint - the aggregates, like SUM(Money) or COUNT(*), and the GROUP BY columns that will be shown on the console
+	/// @param orderByWhat - the shown items the groups are ordered by, each one followed by ASC or DESC or not (empty for no order)
+	/// @param sink - called with every group in string format
+	/// @param limit - the maximum number of groups
+	/// @return the number of groups
+	size_t aggregate(const string& expression, const string& groupBy, const string& toPrint, const string& orderByWhat,
+		const function<void(const string&)>& sink, size_t limit = NO_LIMIT) const;
+
+	/// @brief Counts the rows of the table that satisfy given criteria. If the criteria use only indexed columns,
+	/// the rows are counted from the indexes without reading any page.
+	/// @param expression - the WHERE expression
+	/// @return the number of rows
+	size_t count(const string& expression) const;
+
+	/// @brief Removes records from the table by given criteria
+	/// @param expression - the criteria expression in string format
+	void remove(const string& expression);
+
+	/// @brief Creates an index on a given column for faster searching in this column
+	/// @param indexCol - the column to be indexed
+	void createIndex(const string& indexCol);
+
+	/// @brief Writes the rows of the table again into as few pages as possible, in the order of an index,
+	/// and builds every index again with the new places of the rows. The pages after the last written one are dropped.
+	/// @param clusterCol - the indexed column that gives the order of the rows (the first indexed column if empty)
+	void vacuum(const string& clusterCol = "");
+
+	/// @brief Adds a Bloom filter of a column to every page, so a scan for a value of the column
+	/// skips the pages that surely don't have it
+	/// @param col - the column
+	/// @param bitsPerKey - the bits of the filter for every row (more bits give fewer false positives)
+	void createBloomFilter(const string& col, size_t bitsPerKey = DEFAULT_BLOOM_BITS_PER_KEY);
+
+	/// @brief Gets the ammount of the rows in the table
+	/// @return the size of the first column
+	size_t size() const 
+	{ 
+		if (indexedColsRecordsHT.empty()) return 0;
+		return indexedColsRecordsHT.at(indexedCols[0]).getSize();
+	};
+
+	/// @brief Saves the table to a file with name - the name of the table in binary format
+	/// @param fileName - the name of the file (<name_of_table>.bin if empty)
+	void serialize(const string& fileName = "") const;
+
+	/// @brief Gets the header of the table (columns, indexed columns etc.)
+	/// @return the header in string format
+	string getHeaderInfo() const;
+
+	/// @brief Gives the columns that will be printed in the search method
+	/// @param toPrint - columns to be printed
+	/// @return vector of column names to be printed
+	vector<string> getColsNamesToPrint(const string& toPrint) const;
+
+	/// @brief Gets the number of pages of the table
+	inline size_t getPageCount() const { return currPageNumber; }
+
+	/// @brief Gets the size of the pages of the table
+	/// @return the size in bytes
+	inline size_t getPageSize() const { return pageSize; }
+
+	/// @brief Gets the size of the table
+	/// @return the size in bytes
+	inline unsigned int getBytes() const { return bytes; }
+
+private:
+	/// @brief Creates a Page (cached in the buffer pool and written to a file with name - <name_of_table>_page<currPageNumber>)
+	/// @return the newly created page
+	Page& createPage();
+
+	/// @brief Builds the stages of a select that read the rows of the table and filter them
+	/// @param indexedExpr - the conditions on indexed columns (the rows are fetched through the indexes if there are any)
+	/// @param rows - the rows of the conditions on indexed columns (not used if there are none)
+	/// @param condition - the condition on the rest of the columns
+	/// @return the last stage
+	unique_ptr<Operator> scanPlan(const vector<string>& indexedExpr, const RowBitmap& rows, const Predicate& condition) const;
+
+	/// @brief Finds the values of the index of a column that the selected rows can have
+	/// @param indexedExpr - the conditions on indexed columns
+	/// @param col - the column
+	/// @return the bounds from the comparisons of the column joined with AND (no bounds if there is an OR between them)
+	IndexBounds indexBounds(const vector<string>& indexedExpr, const string& col) const;
+
+	/// @brief Decides if the values of the selected rows are taken from the leaves of the indexes instead of the pages
+	/// @param rows - the selected rows
+	/// @param bounds - the bounds of the walk of every index
+	/// @param limit - the maximum number of selected rows
+	/// @return true if the walks of the leaves cost less than reading the rows (and the values of more columns fit in the memory of a sort)
+	bool useIndexOnly(const RowBitmap& rows, const vector<IndexBounds>& bounds, size_t limit) const;
+
+	/// @brief Checks if a walk of the leaves of an index costs less than reading the selected rows from the pages
+	/// @param rows - the selected rows
+	/// @param bounds - the bounds of the walk
+	/// @param limit - the number of rows after which the walk stops
+	/// @return true if the walk reads at most INDEX_ONLY_MIN_SHARE leaves for every selected row
+	bool cheapWalk(const RowBitmap& rows, const IndexBounds& bounds, size_t limit) const;
+
+	/// @brief Parses the columns of an ORDER BY
+	/// @param orderByWhat - the columns, each one followed by ASC or DESC or not
+	/// @param scanCols - the columns the select reads, the columns of the order that aren't in it are added after the rest
+	/// @param addMissing - false if the columns of the order must be in scanCols (the items of an aggregate)
+	/// @return the columns of the order as indexes in scanCols
+	vector<SortKey> parseOrderBy(const string& orderByWhat, vector<string>& scanCols, bool addMissing = true) const;
+
+	/// @brief Parses an aggregate, like SUM(Money) or COUNT(*)
+	/// @param item - the item of an aggregate select
+	/// @param aggregate - set to the aggregate, its column is the index of the column in the table
+	/// @return false if the item is a column and not an aggregate
+	bool parseAggregate(const string& item, Aggregate& aggregate) const;
+
+	/// @brief Stores parsed rows in the pages with space for them and adds them to every index with one sorted batch
+	/// @param records - the rows
+	void insertRecords(const vector<Record>& records);
+
+	/// @brief Guesses how many rows the last page will get, to size its Bloom filters
+	/// @return the number of rows of the page before it, or a guess from the page size if there is none
+	size_t estimateRowsPerPage() const;
+
+	/// @brief Builds the zone map of a page again from its slots (after rows were removed from it)
+	/// @param pageNum - the number of the page
+	/// @param page - the page
+	void updateZoneMap(size_t pageNum, const Page& page);
+
+	/// @brief Gives the types of the columns, saved in every page so the values are stored without type tags
+	/// @return the types in the order of the columns
+	vector<DataType> columnTypes() const;
+
+	/// @brief Initializes some of the data structures used in the table
+	/// @param header - header of the table
+	void setCollections(const string& header);
+
+	/// @brief Converts a string to a Record
+	/// @param str - string to be converted
+	/// @return the Record converted from the string
+	Record toRecord(const string& str) const;
+
+	inline bool isNumber(const char c) const { return c >= '0' && c <= '9'; };
+
+	/// @brief Checks if a string is an Integer object
+	/// @param data - the string to be checked
+	/// @return true if the string is Integer and false otherwise
+	bool isInteger(const string& data) const;
+
+	/// @brief Checks if a string is a Double object
+	/// @param data - the string to be checked
+	/// @return true if the string is Double and false otherwise
+	bool isDouble(const string& data) const;
+
+	/// @brief Checks if a string is a String object
+	/// @param data - the string to be checked
+	/// @return true if the string is String and false otherwise
+	bool isString(const string& data) const;
+
+	/// @brief Checks if a string is a DateTime object
+	/// @param data - the string to be checked
+	/// @return true if the string is DateTime and false otherwise
+	bool isDateTime(const std::string& str) const;
+
+	/// @brief Parses an expression from the search method
+	/// @param expression - the expression to be parsed
+	/// @return a vector of strings of the parsed expression
+	vector<string> parseExpression(const string& expression) const;
+
+	/// @brief Checks if a vector of strings contains only the names of the indexed columns
+	/// @param arr - the vector
+	/// @return true if the vec contains only the names of the indexed columns and false otherwise
+	bool containsOnlyIndexedCols(const vector<string>& arr) const;
+
+	/// @brief Splits a search expression by its top level ANDs into the part that the indexes can answer and the rest
+	/// @param expressionArr - the parsed search expression
+	/// @param indexed - the conjuncts that use only indexed columns, joined with AND
+	/// @param residual - the other conjuncts, joined with AND (checked for every row the indexes give)
+	void splitConjuncts(const vector<string>& expressionArr, vector<string>& indexed, vector<string>& residual) const;
+
+	/// @brief Compiles a search expression into a predicate, resolving the columns and converting the values once
+	/// @param expression - the parsed search expression
+	/// @return the predicate (empty if the expression is empty)
+	Predicate compileCondition(const vector<string>& expression) const;
+
+	/// @brief Converts a logical operation to the operation of a predicate
+	/// @param oper - "AND", "OR" or "NOT"
+	/// @return the operation
+	Predicate::Op toLogicalOp(const string& oper) const;
+
+	inline bool isLogicalOpOrBracket(const string& str) const
+	{
+		return str == "(" || str == ")" || str == "AND" || str == "OR" || str == "NOT";
+	}
+
+	/// @brief Gets the precedence of a given logical operation
+	/// @param arg - the logical operation
+	/// @return number depending on the operation
+	size_t precedence(const string& arg) const;
+
+	/// @brief Checks the type of a Data object
+	/// @param data - the Data in a string format
+	/// @return the type of the object in a string format
+	string checkRightType(const string& data) const;
+
+	/// @brief Uses shunting yard algorithm with row bitmaps, intersection, union and complement
+	/// @param expressionArr - the search expression
+	/// @return - the result set ordered by page and row
+	vector<RecordPtr> getIntervals(const vector<string>& expressionArr) const;
+
+	/// @brief Converts a value of a condition to the type of a column, like the keys of its index
+	/// @param colName - the name of the column
+	/// @param value - the value in string format
+	/// @return the value
+	Data parseBound(const string& colName, const string& value) const;
+
+	/// @brief Builds an Interval object
+	/// @param colName - the name of the indexed column
+	/// @param bound - one of the bounds of the interval
+	/// @param oper - the comparation operation
+	/// @param type - the type of the Data 
+	/// @return the built Interval object
+	Interval buildInterval(const string& colName, Data& bound, const string& oper, const string& type) const;
+
+	/// @brief Converts a vector of record pointers to vector of records
+	/// @param recordPtrs - the vector of record pointers, ordered by page
+	/// @param records - the vector of records
+	void transformToRecords(const vector<RecordPtr>& recordPtrs, vector<Record>& records) const;
+
+	/// @brief Converts a string of columns to a vector of strings
+	/// @param toPrint - the column names in string format
+	/// @return the vector of column names strings
+	vector<string> parseColsToPrint(const string& toPrint) const;
+
+private:
+	string name;
+	size_t currPageNumber;
+	size_t pageSize; // the size of every new page in bytes
+	unsigned int bytes;
+
+	vector<string> colNames; // ID, Name, Date, Value, ...  
+	vector<string> colTypes; // Int, String, Double, ...		
+	vector<string> indexedCols; // ID, ...					
+	unordered_map<string, size_t> colNameIndexHT; // (ID,0), (Name,1), ...
+	unordered_map<string, BPlusTree> indexedColsRecordsHT; // (ID, Tree1), (Name, Tree2), ...
+	RowBitmap liveRows; // the rows that aren't removed
+	vector<ZoneMap> zoneMaps; // the summary of every page, zoneMaps[i] is for page i + 1
+	vector<size_t> bloomBitsPerKey; // the bits per row of the Bloom filter of every column (0 for no filter)
+	FreeSpaceMap freeSpaceMap; // the space for new rows in every page
+};
+
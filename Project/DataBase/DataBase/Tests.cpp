@@ -1,463 +1,1875 @@
-#define CATCH_CONFIG_MAIN 
-#include <cassert>
-#include "catch2.hpp"
-#include "Table.h"
-
-TEST_CASE("Integer Constructor", "[Integer]")
-{
-	SECTION("Integer_GivenNoValue_Creates")
-	{
-		Integer i;
-
-		REQUIRE(i.toInteger() == 0);
-		REQUIRE(i.toString() == "0");
-		REQUIRE(i.getBytes() == 4);
-	}
-	SECTION("Integer_GivenValue_Creates")
-	{
-		Integer i(123);
-
-		REQUIRE(i.toInteger() == 123);
-		REQUIRE(i.toString() == "123");
-		REQUIRE(i.getBytes() == 4);
-	}
-}
-
-TEST_CASE("Integer Operators", "[operator]")
-{
-	SECTION("Integer_Compares")
-	{
-		Integer i1(5);
-		Integer i2(10);
-
-		REQUIRE(i1 < i2);
-		REQUIRE(i1 <= i2);
-		REQUIRE(i1 == i1);
-		REQUIRE(i2 >= i1);
-		REQUIRE(i2 > i1);
-	}
-}
-
-TEST_CASE("Double Constructor", "[Double]")
-{
-	SECTION("Double_GivenNoValue_Creates")
-	{
-		Double d;
-
-		REQUIRE(d.toDouble() == 0);
-		REQUIRE(d.toString() == "0.000");
-		REQUIRE(d.getBytes() == 8);
-	}
-	SECTION("Double_GivenValue_Creates")
-	{
-		Double d(6.574);
-
-		REQUIRE(d.toDouble() == 6.574);
-		REQUIRE(d.toString() == "6.574");
-		REQUIRE(d.getBytes() == 8);
-	}
-}
-
-TEST_CASE("Double Operators", "[operator]")
-{
-	SECTION("Double_Compares")
-	{
-		Double d1(5.65);
-		Double d2(6.87);
-
-		REQUIRE(d1 < d2);
-		REQUIRE(d1 <= d2);
-		REQUIRE(d1 == d1);
-		REQUIRE(d2 >= d1);
-		REQUIRE(d2 > d1);
-	}
-}
-
-TEST_CASE("String Constructor", "[String]")
-{
-	SECTION("String_GivenNoValue_Creates")
-	{
-		String s;
-
-		REQUIRE(s.toDouble() == 0);
-		REQUIRE(s.toInteger() == 0);
-		REQUIRE(s.toString() == "");
-		REQUIRE(s.getBytes() == 28);
-	}
-	SECTION("String_GivenValue_Creates")
-	{
-		String s("Deyan");
-
-		REQUIRE(s.toString() == "Deyan");
-		REQUIRE(s.getBytes() == 28);
-	}
-	SECTION("String_GivenNumValue_Creates")
-	{
-		String s("65");
-
-		REQUIRE(s.toInteger() == 65);
-		REQUIRE(s.toDouble() == 65);
-		REQUIRE(s.toString() == "65");
-		REQUIRE(s.getBytes() == 28);
-	}
-}
-
-TEST_CASE("String Operators", "[operator]")
-{
-	SECTION("String_Compares")
-	{
-		String s1("Alex");
-		String s2("Ivan");
-
-		REQUIRE(s1 < s2);
-		REQUIRE(s1 <= s2);
-		REQUIRE(s1 == s1);
-		REQUIRE(s2 >= s1);
-		REQUIRE(s2 > s1);
-	}
-}
-
-TEST_CASE("DateTime Constructor", "[DateTime]")
-{
-	SECTION("DateTime_GivenNoValue_Creates")
-	{
-		DateTime d;
-
-		REQUIRE(d.toString() == "1-1-1");
-		REQUIRE(d.getBytes() == 12);
-	}
-	SECTION("DateTime_GivenValue_Creates")
-	{
-		DateTime d("20-4-2000");
-
-		REQUIRE(d.toString() == "20-4-2000");
-		REQUIRE(d.getBytes() == 12);
-	}
-	SECTION("DateTime_GivenInvalidValue_Throws")
-	{
-		REQUIRE_THROWS(DateTime("32-4-2000"));
-		REQUIRE_THROWS(DateTime("30-14-2000"));
-		REQUIRE_THROWS(DateTime("30-2-1985"));
-		REQUIRE_THROWS(DateTime("31-4-1985"));
-	}
-}
-
-TEST_CASE("DateTime Operators", "[operator]")
-{
-	SECTION("DateTime_Compares")
-	{
-		DateTime d1("25-12-1985");
-		DateTime d2("26-10-1986");
-
-		REQUIRE(d1 < d2);
-		REQUIRE(d1 <= d2);
-		REQUIRE(d1 == d1);
-		REQUIRE(d2 >= d1);
-		REQUIRE(d2 > d1);
-	}
-}
-
-TEST_CASE("Data OperatorsAndConstructors", "[operator]")
-{
-	SECTION("Data_Compares")
-	{
-		Data first(5);
-		Data second(10);
-		Data third(first);
-
-		REQUIRE(first < second);
-		REQUIRE(first <= second);
-		REQUIRE(first == first);
-		REQUIRE(second >= first);
-		REQUIRE(second > first);
-		REQUIRE(first.getBytes() == third.getBytes());
-		REQUIRE(first.toString() == third.toString());
-
-		third.~Data();
-		REQUIRE(nullptr == third.getValue());
-
-		second = first;
-		REQUIRE(first.getBytes() == second.getBytes());
-		REQUIRE(first.toString() == second.toString());
-	}
-}
-
-TEST_CASE("Interval Constructor", "[Interval]")
-{
-	SECTION("Interval_GivenValue_Creates")
-	{
-		Interval i(Data(5), Data(8), "ID", "Int", false);
-
-		REQUIRE(i.getLeftBound() == 5);
-		REQUIRE(i.getRightBound() == 8);
-		REQUIRE(i.getColName() == "ID");
-		REQUIRE(i.isEmpty() == false);
-		REQUIRE(i.toString() == "Int 5 8 ID false");
-
-		Interval i2(Data("devet"), Data("sto"), "Val", "String", true);
-
-		REQUIRE(i2.getLeftBound() == Data("devet"));
-		REQUIRE(i2.getRightBound() == Data("sto"));
-		REQUIRE(i2.getColName() == "Val");
-		REQUIRE(i2.isEmpty() == true);
-		REQUIRE(i2.toString() == "String devet sto Val true");
-	}
-}
-
-TEST_CASE("Page Constructor", "[Page]")
-{
-	SECTION("Page_GivenValue_Creates")
-	{
-		Page p(10);
-
-		REQUIRE(p.isEmpty() == true);
-		REQUIRE(p.isFull() == false);
-		REQUIRE(p.size() == 0);
-	}
-}
-
-TEST_CASE("Page Methods", "[method]")
-{
-	SECTION("Page_AddRecord_Adds")
-	{
-		Page p(1);
-		Record r;
-		r.addColumn(Data(5));
-		p.addRecord(r);
-
-		REQUIRE(p.isEmpty() == false);
-		REQUIRE(p.isFull() == true);
-		REQUIRE(p.size() == 1);
-	}
-	SECTION("Page_RemoveRecord_Removes")
-	{
-		Page p(3);
-		Record r;
-		r.addColumn(Data(5));
-		p.addRecord(r);
-		p.removeRecord(0);
-
-		REQUIRE(p.getRecord(0).getBytes() == 0);
-	}
-	SECTION("Page_GetRecord_Gets")
-	{
-		Page p(3);
-		Record r;
-		r.addColumn(Data(5));
-		p.addRecord(r);
-
-		REQUIRE(p.getRecord(0).getBytes() == 4);
-		REQUIRE(p.getRecord(0).getColData(0) == r.getColData(0));
-	}
-	SECTION("Page_GivenInvalidIndex_Thros")
-	{
-		Page p(3);
-		Record r;
-		r.addColumn(Data(5));
-		p.addRecord(r);
-
-		REQUIRE_THROWS(p.getRecord(1));
-		REQUIRE_THROWS(p.removeRecord(1));
-	}
-}
-
-TEST_CASE("Record Constructor", "[Record]")
-{
-	SECTION("Record_GivenNoValue_Creates")
-	{
-		Record r;
-
-		REQUIRE(r.isEmpty() == true);
-		REQUIRE(r.size() == 0);
-		REQUIRE(r.getBytes() == 0);
-	}
-}
-
-TEST_CASE("Record Methods", "[method]")
-{
-	SECTION("Record_GivenNoValue_Creates")
-	{
-		Record r;
-
-		REQUIRE(r.isEmpty() == true);
-		REQUIRE(r.size() == 0);
-		REQUIRE(r.getBytes() == 0);
-
-		r.addColumn(Data(5));
-		r.clear();
-		REQUIRE(r.isEmpty() == true);
-		REQUIRE(r.size() == 0);
-		REQUIRE(r.getBytes() == 0);
-	}
-	SECTION("Record_GivenDataToInsert_Adds")
-	{
-		Record r;
-		r.addColumn(Data(5));
-		r.addColumn(Data("Pesho"));
-
-		REQUIRE(r.isEmpty() == false);
-		REQUIRE(r.size() == 2);
-		REQUIRE(r.getBytes() == 32);
-	}
-	SECTION("Record_GivenIndex_GetsData")
-	{
-		Record r;
-		r.addColumn(Data(5));
-		r.addColumn(Data("Pesho"));
-
-		REQUIRE(r.getColData(0) == 5);
-		REQUIRE(r.getColData(1) == Data("Pesho"));
-	}
-	SECTION("Record_GivenInvalidIndex_Throws")
-	{
-		Record r;
-		r.addColumn(Data(5));
-		r.addColumn(Data("Pesho"));
-
-		REQUIRE_THROWS(r.getColData(2));
-	}
-}
-
-TEST_CASE("RecordPtr Constructor", "[RecordPtr]")
-{
-	SECTION("RecordPtr_GivenValue_Creates")
-	{
-		RecordPtr recPtr(1, 6);
-
-		REQUIRE(recPtr.pageNumber() == 1);
-		REQUIRE(recPtr.rowNumber() == 6);
-	}
-}
-
-TEST_CASE("RecordPtr Operators", "[operator]")
-{
-	SECTION("RecordPtr_Compares")
-	{
-		RecordPtr r1(1, 6);
-		RecordPtr r2(1, 8);
-		RecordPtr r3(2, 1);
-
-		REQUIRE(r1 < r2);
-		REQUIRE(r1 == r1);
-		REQUIRE(r2 > r1);
-		REQUIRE(r1 < r3);
-	}
-}
-
-TEST_CASE("BPlusTree Constructors", "[BPlusTree]")
-{
-	SECTION("BPlusTree_EmptyTree_Creates")
-	{
-		BPlusTree tree;
-
-		REQUIRE(tree.getSize() == 0);
-		REQUIRE(tree.isEmpty() == true);
-	}
-	SECTION("BPlusTree_CopyConstructor_Copies")
-	{
-		BPlusTree tree;
-		tree.insert({ Data(5), RecordPtr(1,1) });
-
-		BPlusTree tree2(tree);
-
-		REQUIRE(tree2.getSize() == 1);
-		REQUIRE(tree2.isEmpty() == false);
-		REQUIRE(tree2.find(Data(5)));
-	}
-	SECTION("BPlusTree_operator=_Copies")
-	{
-		BPlusTree tree;
-		tree.insert({ Data(5), RecordPtr(1,1) });
-
-		BPlusTree tree2;
-		tree2.insert({ Data(10), RecordPtr(1,1) });
-
-		tree2 = tree;
-
-		REQUIRE(tree2.getSize() == 1);
-		REQUIRE(tree2.isEmpty() == false);
-		REQUIRE(tree2.find(Data(5)));
-	}
-	SECTION("BPlusTree_Destructor_Clears")
-	{
-		BPlusTree tree;
-		for (int i = 0; i < 10; i++)
-		{
-			tree.insert({ Data(i), RecordPtr(i,i) });
-		}
-
-		tree.~BPlusTree();
-
-		REQUIRE(tree.getSize() == 0);
-		REQUIRE(tree.isEmpty() == true);
-	}
-}
-
-TEST_CASE("BPlusTree Insert, Min, Max, GetElementsInRange")
-{
-	SECTION("BPlusTree_Insert_GivenElement_Insert")
-	{
-		BPlusTree tree;
-		vector<RecordPtr> vec;
-		for (int i = 0; i < 100; i++)
-		{
-			tree.insert({ Data(i), RecordPtr(i,i) });
-		}
-		vec = tree.getElementsInRange(tree.min(), tree.max());
-
-		REQUIRE(tree.getSize() == 100);
-		REQUIRE(tree.isEmpty() == false);
-		REQUIRE(tree.min() == 0);
-		REQUIRE(tree.max() == 99);
-
-		for (int i = 0; i < 100; i++)
-		{
-			REQUIRE(vec[i] == RecordPtr(i, i));
-		}
-	}
-}
-
-TEST_CASE("BPlusTree Remove")
-{
-	SECTION("BPlusTree_Remove_GivenElement_Remove")
-	{
-		BPlusTree tree(3);
-		for (int i = 0; i < 100; i++)
-		{
-			tree.insert({ Data(i), RecordPtr(i,i) });
-		}
-
-		tree.remove({ Data(5), RecordPtr(5,5) });
-
-		REQUIRE(tree.getSize() == 99);
-
-		for (int i = 0; i < 5; i++)
-		{
-			tree.remove({ Data(i), RecordPtr(i,i) });
-		}
-		for (int i = 6; i < 100; i++)
-		{
-			tree.remove({ Data(i), RecordPtr(i,i) });
-		}
-
-		REQUIRE(tree.getSize() == 0);
-		REQUIRE(tree.isEmpty() == true);
-	}
-}
-
-TEST_CASE("BPlusTree Find")
-{
-	SECTION("BPlusTree_Find_GivenElement_Finds")
-	{
-		BPlusTree tree(3);
-		for (int i = 0; i < 100; i++)
-		{
-			tree.insert({ Data(i), RecordPtr(i,i) });
-		}
-
-		for (int i = 0; i < 100; i++)
-		{
-			REQUIRE(tree.find(Data(i)));
-		}
-	}
-}
\ No newline at end of file
+#define CATCH_CONFIG_MAIN 
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include "catch2.hpp"
+#include "Table.h"
+
+/// @brief Removes the files a test writes when the test ends, even if it fails
+class TestFiles
+{
+public:
+	/// @param files - the names of the files
+	/// @param tables - the names of the tables, their segments are closed and their table and segment files are removed
+	TestFiles(vector<string> files, vector<string> tables = {})
+		: files(std::move(files))
+		, tables(std::move(tables))
+	{}
+
+	~TestFiles()
+	{
+		for (const string& table : tables)
+		{
+			BufferPool::i().closeSegment(table);
+			files.push_back(table + ".bin");
+			files.push_back(table + "_pages.bin");
+		}
+
+		std::error_code error;
+		for (const string& file : files)
+			std::filesystem::remove(file, error);
+	}
+
+private:
+	vector<string> files;
+	vector<string> tables;
+};
+
+TEST_CASE("Integer Constructor", "[Integer]")
+{
+	SECTION("Integer_GivenNoValue_Creates")
+	{
+		Integer i;
+
+		REQUIRE(i.toInteger() == 0);
+		REQUIRE(i.toString() == "0");
+		REQUIRE(i.getBytes() == 4);
+	}
+	SECTION("Integer_GivenValue_Creates")
+	{
+		Integer i(123);
+
+		REQUIRE(i.toInteger() == 123);
+		REQUIRE(i.toString() == "123");
+		REQUIRE(i.getBytes() == 4);
+	}
+}
+
+TEST_CASE("Integer Operators", "[operator]")
+{
+	SECTION("Integer_Compares")
+	{
+		Integer i1(5);
+		Integer i2(10);
+
+		REQUIRE(i1 < i2);
+		REQUIRE(i1 <= i2);
+		REQUIRE(i1 == i1);
+		REQUIRE(i2 >= i1);
+		REQUIRE(i2 > i1);
+	}
+}
+
+TEST_CASE("Double Constructor", "[Double]")
+{
+	SECTION("Double_GivenNoValue_Creates")
+	{
+		Double d;
+
+		REQUIRE(d.toDouble() == 0);
+		REQUIRE(d.toString() == "0.000");
+		REQUIRE(d.getBytes() == 8);
+	}
+	SECTION("Double_GivenValue_Creates")
+	{
+		Double d(6.574);
+
+		REQUIRE(d.toDouble() == 6.574);
+		REQUIRE(d.toString() == "6.574");
+		REQUIRE(d.getBytes() == 8);
+	}
+}
+
+TEST_CASE("Double Operators", "[operator]")
+{
+	SECTION("Double_Compares")
+	{
+		Double d1(5.65);
+		Double d2(6.87);
+
+		REQUIRE(d1 < d2);
+		REQUIRE(d1 <= d2);
+		REQUIRE(d1 == d1);
+		REQUIRE(d2 >= d1);
+		REQUIRE(d2 > d1);
+	}
+}
+
+TEST_CASE("String Constructor", "[String]")
+{
+	SECTION("String_GivenNoValue_Creates")
+	{
+		String s;
+
+		REQUIRE(s.toDouble() == 0);
+		REQUIRE(s.toInteger() == 0);
+		REQUIRE(s.toString() == "");
+		REQUIRE(s.getBytes() == 28);
+	}
+	SECTION("String_GivenValue_Creates")
+	{
+		String s("Deyan");
+
+		REQUIRE(s.toString() == "Deyan");
+		REQUIRE(s.getBytes() == 28);
+	}
+	SECTION("String_GivenNumValue_Creates")
+	{
+		String s("65");
+
+		REQUIRE(s.toInteger() == 65);
+		REQUIRE(s.toDouble() == 65);
+		REQUIRE(s.toString() == "65");
+		REQUIRE(s.getBytes() == 28);
+	}
+}
+
+TEST_CASE("String Operators", "[operator]")
+{
+	SECTION("String_Compares")
+	{
+		String s1("Alex");
+		String s2("Ivan");
+
+		REQUIRE(s1 < s2);
+		REQUIRE(s1 <= s2);
+		REQUIRE(s1 == s1);
+		REQUIRE(s2 >= s1);
+		REQUIRE(s2 > s1);
+	}
+}
+
+TEST_CASE("DateTime Constructor", "[DateTime]")
+{
+	SECTION("DateTime_GivenNoValue_Creates")
+	{
+		DateTime d;
+
+		REQUIRE(d.toString() == "1-1-1");
+		REQUIRE(d.getBytes() == 12);
+	}
+	SECTION("DateTime_GivenValue_Creates")
+	{
+		DateTime d("20-4-2000");
+
+		REQUIRE(d.toString() == "20-4-2000");
+		REQUIRE(d.getBytes() == 12);
+	}
+	SECTION("DateTime_GivenInvalidValue_Throws")
+	{
+		REQUIRE_THROWS(DateTime("32-4-2000"));
+		REQUIRE_THROWS(DateTime("30-14-2000"));
+		REQUIRE_THROWS(DateTime("30-2-1985"));
+		REQUIRE_THROWS(DateTime("31-4-1985"));
+	}
+}
+
+TEST_CASE("DateTime Operators", "[operator]")
+{
+	SECTION("DateTime_Compares")
+	{
+		DateTime d1("25-12-1985");
+		DateTime d2("26-10-1986");
+
+		REQUIRE(d1 < d2);
+		REQUIRE(d1 <= d2);
+		REQUIRE(d1 == d1);
+		REQUIRE(d2 >= d1);
+		REQUIRE(d2 > d1);
+	}
+}
+
+TEST_CASE("Data OperatorsAndConstructors", "[operator]")
+{
+	SECTION("Data_Compares")
+	{
+		Data first(5);
+		Data second(10);
+		Data third(first);
+
+		REQUIRE(first < second);
+		REQUIRE(first <= second);
+		REQUIRE(first == first);
+		REQUIRE(second >= first);
+		REQUIRE(second > first);
+		REQUIRE(first.getBytes() == third.getBytes());
+		REQUIRE(first.toString() == third.toString());
+
+		third.~Data();
+		REQUIRE(third.isNull());
+
+		second = first;
+		REQUIRE(first.getBytes() == second.getBytes());
+		REQUIRE(first.toString() == second.toString());
+	}
+}
+
+TEST_CASE("Data Values", "[Data]")
+{
+	SECTION("Data_LongAndShortStrings_CopyAndMove")
+	{
+		Data shortStr("\"Ivan\"");
+		Data longStr("\"a string longer than the inline buffer\"");
+		REQUIRE(longStr.toString().size() > Data::SSO_CAPACITY);
+
+		Data copied(longStr);
+		Data moved(std::move(copied));
+		REQUIRE(moved == longStr);
+		REQUIRE(copied.isNull());
+
+		moved = shortStr;
+		REQUIRE(moved.toString() == "\"Ivan\"");
+		REQUIRE(Data("\"IVAN\"") == shortStr);
+	}
+	SECTION("Data_DifferentTypes_ConvertsOther")
+	{
+		REQUIRE(Data(5.5) > Data(5));
+		REQUIRE(Data(5) == Data(5.5));
+		REQUIRE(Data("20-4-2000") < Data("21-4-2000"));
+		REQUIRE(Data("1-1-2001") > Data("31-12-2000"));
+		REQUIRE(Data().isNull());
+		REQUIRE(Data() < Data(0));
+	}
+	SECTION("Data_Equals_ComparesTypesAndPrintedValues")
+	{
+		REQUIRE(Data("\"Ivan\"").equals(Data("\"Ivan\"")));
+		REQUIRE_FALSE(Data("\"Ivan\"").equals(Data("\"ivan\"")));
+		REQUIRE_FALSE(Data(5).equals(Data(5.0)));
+		REQUIRE(Data().equals(Data()));
+
+		// close numbers are the same if they are printed the same
+		REQUIRE(Data(1.0001).equals(Data(1.0002)));
+		REQUIRE(Data(1.0001).hash() == Data(1.0002).hash());
+		REQUIRE(Data(-0.0).equals(Data(0.0)));
+		REQUIRE(Data(-0.0).hash() == Data(0.0).hash());
+		REQUIRE_FALSE(Data(1.001).equals(Data(1.002)));
+	}
+	SECTION("Data_AppendSortKey_ComparesLikeValues")
+	{
+		auto key = [](const Data& data, bool descending = false)
+		{
+			string res;
+			data.appendSortKey(res, descending);
+			return res;
+		};
+
+		REQUIRE(key(Data(-5)) < key(Data(3)));
+		REQUIRE(key(Data(-2.5)) < key(Data(-1.25)));
+		REQUIRE(key(Data(-1.25)) < key(Data(0.5)));
+		REQUIRE(key(Data("1-1-2001")) > key(Data("31-12-2000")));
+		REQUIRE(key(Data("\"abc\"")) < key(Data("\"ABD\"")));
+		REQUIRE(key(Data("\"ABD\"")) < key(Data("\"abde\"")));
+		REQUIRE(key(Data("\"Ivan\"")) != key(Data("\"ivan\"")));
+		REQUIRE(key(Data()) < key(Data(0)));
+		REQUIRE(key(Data(3), true) < key(Data(-5), true));
+		REQUIRE(key(Data("\"abde\""), true) < key(Data("\"ab\""), true));
+
+		// the key of a shorter string isn't a prefix of the key of a longer one
+		string shorter = key(Data("\"ab\"")) + key(Data(9));
+		string longer = key(Data("\"abc\"")) + key(Data(1));
+		REQUIRE(shorter < longer);
+	}
+}
+
+TEST_CASE("Data Encoding", "[Data]")
+{
+	SECTION("Data_Encode_Decodes")
+	{
+		vector<Data> values = { Data(0), Data(-1), Data(300), Data(-2147483647 - 1), Data(2.5),
+			Data("\"Pesho\""), Data("\"\""), Data("20-4-2000"), Data("31-12-9999") };
+
+		for (size_t i = 0; i < values.size(); i++)
+		{
+			vector<char> buffer(values[i].encodedSize());
+			size_t offset = 0;
+			values[i].encode(&buffer[0], offset);
+			REQUIRE(offset == buffer.size());
+
+			offset = 0;
+			Data decoded(&buffer[0], offset);
+			REQUIRE(offset == buffer.size());
+			REQUIRE(decoded.getType() == values[i].getType());
+			REQUIRE(decoded.toString() == values[i].toString());
+		}
+	}
+	SECTION("Data_Encode_IsCompact")
+	{
+		REQUIRE(Data(5).encodedSize() == 2);
+		REQUIRE(Data(5).encodedSize(false) == 1);
+		REQUIRE(Data(-1000).encodedSize() == 3);
+		REQUIRE(Data(2.5).encodedSize() == 9);
+		REQUIRE(Data("\"Ivo\"").encodedSize() == 7);
+		REQUIRE(Data("20-4-2000").encodedSize() == 4);
+	}
+	SECTION("Data_DecodeWithoutTag_UsesGivenType")
+	{
+		Data date("15-12-2001");
+		vector<char> buffer(date.encodedSize(false));
+		size_t offset = 0;
+		date.encode(&buffer[0], offset, false);
+
+		offset = 0;
+		Data decoded(&buffer[0], offset, DataType::DateTime);
+		REQUIRE(decoded == date);
+	}
+}
+
+TEST_CASE("Interval Constructor", "[Interval]")
+{
+	SECTION("Interval_GivenValue_Creates")
+	{
+		Interval i(Data(5), Data(8), "ID", "Int", false);
+
+		REQUIRE(i.getLeftBound() == 5);
+		REQUIRE(i.getRightBound() == 8);
+		REQUIRE(i.getColName() == "ID");
+		REQUIRE(i.isEmpty() == false);
+		REQUIRE(i.toString() == "Int 5 8 ID false");
+
+		Interval i2(Data("devet"), Data("sto"), "Val", "String", true);
+
+		REQUIRE(i2.getLeftBound() == Data("devet"));
+		REQUIRE(i2.getRightBound() == Data("sto"));
+		REQUIRE(i2.getColName() == "Val");
+		REQUIRE(i2.isEmpty() == true);
+		REQUIRE(i2.toString() == "String devet sto Val true");
+	}
+}
+
+TEST_CASE("Page Constructor", "[Page]")
+{
+	SECTION("Page_GivenValue_Creates")
+	{
+		Page p(10);
+
+		REQUIRE(p.isEmpty() == true);
+		REQUIRE(p.isFull() == false);
+		REQUIRE(p.size() == 0);
+	}
+}
+
+TEST_CASE("Page Methods", "[method]")
+{
+	SECTION("Page_AddRecord_Adds")
+	{
+		Page p(1);
+		Record r;
+		r.addColumn(Data(5));
+		p.addRecord(r);
+
+		REQUIRE(p.isEmpty() == false);
+		REQUIRE(p.isFull() == true);
+		REQUIRE(p.size() == 1);
+	}
+	SECTION("Page_RemoveRecord_Removes")
+	{
+		Page p(3);
+		Record r;
+		r.addColumn(Data(5));
+		p.addRecord(r);
+		p.removeRecord(0);
+
+		REQUIRE(p.getRecord(0).getBytes() == 0);
+	}
+	SECTION("Page_GetRecord_Gets")
+	{
+		Page p(3);
+		Record r;
+		r.addColumn(Data(5));
+		p.addRecord(r);
+
+		REQUIRE(p.getRecord(0).getBytes() == 4);
+		REQUIRE(p.getRecord(0).getColData(0) == r.getColData(0));
+	}
+	SECTION("Page_Serialize_KeepsSlots")
+	{
+		Page p(3);
+		Record r1, r2;
+		r1.addColumn(Data(5));
+		r1.addColumn(Data("Pesho"));
+		r2.addColumn(Data(6.5));
+		r2.addColumn(Data("20-4-2000"));
+		p.addRecord(r1);
+		p.addRecord(r2);
+		p.removeRecord(0);
+
+		TestFiles testFiles({ "page_test.bin" });
+		std::ofstream out("page_test.bin", std::ios::binary);
+		p.serialize(out);
+		out.close();
+
+		std::ifstream in("page_test.bin", std::ios::binary);
+		REQUIRE(Page::isPageImage(in) == true);
+		Page loaded(in);
+		in.close();
+
+		REQUIRE(loaded.size() == 2);
+		REQUIRE(loaded.getPageSize() == PAGE_SIZE);
+		REQUIRE(loaded.getRecord(0).isEmpty() == true);
+		REQUIRE(loaded.getRecord(1).getColData(0) == Data(6.5));
+		REQUIRE(loaded.getRecord(1).getColData(1).toString() == "20-4-2000");
+	}
+	SECTION("Page_Typed_StoresRecordsWithoutTags")
+	{
+		Page typed(3, PAGE_SIZE, { DataType::Int, DataType::String });
+		Page untyped(3);
+		Record r;
+		r.addColumn(Data(5));
+		r.addColumn(Data("\"Pesho\""));
+		typed.addRecord(r);
+		untyped.addRecord(r);
+
+		REQUIRE(typed.isTyped() == true);
+		REQUIRE(typed.getRecord(0).getColData(1) == r.getColData(1));
+		REQUIRE(untyped.getRecord(0).getColData(0) == r.getColData(0));
+
+		Record wrong;
+		wrong.addColumn(Data(5.5));
+		wrong.addColumn(Data("\"Pesho\""));
+		REQUIRE_THROWS(typed.addRecord(wrong));
+	}
+	SECTION("Page_GivenTooBigRecord_Throws")
+	{
+		Page p(3, 64);
+		Record r;
+		r.addColumn(Data("\"a string that doesn't fit in a page of 64 bytes\""));
+
+		REQUIRE(p.canAdd(r) == false);
+		REQUIRE_THROWS(p.addRecord(r));
+	}
+	SECTION("Page_InsertRecord_ReusesEmptySlot")
+	{
+		Page p(0, 128);
+		Record r;
+		r.addColumn(Data("\"0123456789\""));
+		while (p.canAdd(r))
+			p.addRecord(r);
+		size_t slots = p.size();
+		REQUIRE(slots > 1);
+
+		Record other;
+		other.addColumn(Data("\"abcdefghij\""));
+		REQUIRE(p.canInsert(other) == false);
+
+		p.removeRecord(0);
+		REQUIRE(p.hasEmptySlot() == true);
+		REQUIRE(p.canInsert(other) == true);
+		REQUIRE(p.insertRecord(other) == 0);
+		REQUIRE(p.size() == slots);
+		REQUIRE(p.getRecord(0).getColData(0) == other.getColData(0));
+		REQUIRE(p.getRecord(1).getColData(0) == r.getColData(0));
+		REQUIRE(p.hasEmptySlot() == false);
+	}
+	SECTION("Page_GivenInvalidIndex_Thros")
+	{
+		Page p(3);
+		Record r;
+		r.addColumn(Data(5));
+		p.addRecord(r);
+
+		REQUIRE_THROWS(p.getRecord(1));
+		REQUIRE_THROWS(p.removeRecord(1));
+	}
+}
+
+TEST_CASE("Record Constructor", "[Record]")
+{
+	SECTION("Record_GivenNoValue_Creates")
+	{
+		Record r;
+
+		REQUIRE(r.isEmpty() == true);
+		REQUIRE(r.size() == 0);
+		REQUIRE(r.getBytes() == 0);
+	}
+}
+
+TEST_CASE("Record Methods", "[method]")
+{
+	SECTION("Record_GivenNoValue_Creates")
+	{
+		Record r;
+
+		REQUIRE(r.isEmpty() == true);
+		REQUIRE(r.size() == 0);
+		REQUIRE(r.getBytes() == 0);
+
+		r.addColumn(Data(5));
+		r.clear();
+		REQUIRE(r.isEmpty() == true);
+		REQUIRE(r.size() == 0);
+		REQUIRE(r.getBytes() == 0);
+	}
+	SECTION("Record_GivenDataToInsert_Adds")
+	{
+		Record r;
+		r.addColumn(Data(5));
+		r.addColumn(Data("Pesho"));
+
+		REQUIRE(r.isEmpty() == false);
+		REQUIRE(r.size() == 2);
+		REQUIRE(r.getBytes() == 32);
+	}
+	SECTION("Record_GivenIndex_GetsData")
+	{
+		Record r;
+		r.addColumn(Data(5));
+		r.addColumn(Data("Pesho"));
+
+		REQUIRE(r.getColData(0) == 5);
+		REQUIRE(r.getColData(1) == Data("Pesho"));
+	}
+	SECTION("Record_GivenInvalidIndex_Throws")
+	{
+		Record r;
+		r.addColumn(Data(5));
+		r.addColumn(Data("Pesho"));
+
+		REQUIRE_THROWS(r.getColData(2));
+	}
+}
+
+TEST_CASE("RecordPtr Constructor", "[RecordPtr]")
+{
+	SECTION("RecordPtr_GivenValue_Creates")
+	{
+		RecordPtr recPtr(1, 6);
+
+		REQUIRE(recPtr.pageNumber() == 1);
+		REQUIRE(recPtr.rowNumber() == 6);
+	}
+}
+
+TEST_CASE("RecordPtr Operators", "[operator]")
+{
+	SECTION("RecordPtr_Compares")
+	{
+		RecordPtr r1(1, 6);
+		RecordPtr r2(1, 8);
+		RecordPtr r3(2, 1);
+
+		REQUIRE(r1 < r2);
+		REQUIRE(r1 == r1);
+		REQUIRE(r2 > r1);
+		REQUIRE(r1 < r3);
+	}
+}
+
+TEST_CASE("RowBitmap Methods", "[RowBitmap]")
+{
+	RowBitmap first({ RecordPtr(3, 1), RecordPtr(1, 0), RecordPtr(1, 70), RecordPtr(2, 5) });
+	RowBitmap second({ RecordPtr(1, 70), RecordPtr(2, 4), RecordPtr(3, 1), RecordPtr(4, 0) });
+
+	SECTION("RowBitmap_GivenUnsortedRows_GivesThemByPage")
+	{
+		vector<RecordPtr> rows = first.toRecordPtrs();
+		REQUIRE(rows == vector<RecordPtr>{ RecordPtr(1, 0), RecordPtr(1, 70), RecordPtr(2, 5), RecordPtr(3, 1) });
+		REQUIRE(first.size() == 4);
+		REQUIRE(first.contains(RecordPtr(1, 70)));
+		REQUIRE(!first.contains(RecordPtr(1, 6)));
+	}
+	SECTION("RowBitmap_AndOrAndNot_Combine")
+	{
+		RowBitmap both = first;
+		both &= second;
+		REQUIRE(both.toRecordPtrs() == vector<RecordPtr>{ RecordPtr(1, 70), RecordPtr(3, 1) });
+
+		RowBitmap any = first;
+		any |= second;
+		REQUIRE(any.size() == 6);
+
+		RowBitmap onlyFirst = first;
+		onlyFirst -= second;
+		REQUIRE(onlyFirst.toRecordPtrs() == vector<RecordPtr>{ RecordPtr(1, 0), RecordPtr(2, 5) });
+	}
+	SECTION("RowBitmap_AddAndRemove_KeepsNoEmptyPages")
+	{
+		first.add(RecordPtr(2, 0));
+		first.remove(RecordPtr(2, 5));
+		first.remove(RecordPtr(2, 0));
+		first.remove(RecordPtr(3, 1));
+		REQUIRE(first.toRecordPtrs() == vector<RecordPtr>{ RecordPtr(1, 0), RecordPtr(1, 70) });
+
+		first -= first;
+		REQUIRE(first.isEmpty());
+	}
+}
+
+TEST_CASE("BloomFilter Methods", "[BloomFilter]")
+{
+	SECTION("BloomFilter_GivenAddedValues_FindsThem")
+	{
+		BloomFilter filter(100, 10);
+		for (int i = 0; i < 100; i++)
+			filter.add(Data("\"Name" + std::to_string(i) + "\""));
+
+		for (int i = 0; i < 100; i++)
+			REQUIRE(filter.mayContain(Data("\"Name" + std::to_string(i) + "\"")));
+
+		size_t falsePositives = 0;
+		for (int i = 100; i < 1100; i++)
+			falsePositives += filter.mayContain(Data("\"Name" + std::to_string(i) + "\""));
+		REQUIRE(falsePositives < 50);
+
+		filter.clear();
+		REQUIRE(!filter.mayContain(Data("\"Name0\"")));
+	}
+	SECTION("BloomFilter_Disabled_FindsEverything")
+	{
+		BloomFilter filter;
+		REQUIRE(!filter.isEnabled());
+		REQUIRE(filter.mayContain(Data(5)));
+	}
+}
+
+TEST_CASE("FreeSpaceMap Methods", "[FreeSpaceMap]")
+{
+	SECTION("FreeSpaceMap_FindPage_FindsFirstPageWithSpace")
+	{
+		FreeSpaceMap map;
+		REQUIRE(map.findPage(1) == 0);
+
+		for (size_t i = 1; i <= 100; i++)
+			map.update(i, i % 10 * 100);
+
+		REQUIRE(map.getPageCount() == 100);
+		REQUIRE(map.findPage(50) == 1);
+		REQUIRE(map.findPage(850) == 9);
+		REQUIRE(map.findPage(1000) == 0);
+
+		map.update(9, 0);
+		REQUIRE(map.findPage(850) == 19);
+		REQUIRE(map.getSpace(19) == 900);
+		REQUIRE_THROWS(map.getSpace(101));
+	}
+}
+
+TEST_CASE("BPlusTree Constructors", "[BPlusTree]")
+{
+	SECTION("BPlusTree_EmptyTree_Creates")
+	{
+		BPlusTree tree;
+
+		REQUIRE(tree.getSize() == 0);
+		REQUIRE(tree.isEmpty() == true);
+	}
+	SECTION("BPlusTree_CopyConstructor_Copies")
+	{
+		BPlusTree tree;
+		tree.insert({ Data(5), RecordPtr(1,1) });
+
+		BPlusTree tree2(tree);
+
+		REQUIRE(tree2.getSize() == 1);
+		REQUIRE(tree2.isEmpty() == false);
+		REQUIRE(tree2.find(Data(5)));
+	}
+	SECTION("BPlusTree_operator=_Copies")
+	{
+		BPlusTree tree;
+		tree.insert({ Data(5), RecordPtr(1,1) });
+
+		BPlusTree tree2;
+		tree2.insert({ Data(10), RecordPtr(1,1) });
+
+		tree2 = tree;
+
+		REQUIRE(tree2.getSize() == 1);
+		REQUIRE(tree2.isEmpty() == false);
+		REQUIRE(tree2.find(Data(5)));
+	}
+	SECTION("BPlusTree_Destructor_Clears")
+	{
+		BPlusTree tree;
+		for (int i = 0; i < 10; i++)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+
+		tree.~BPlusTree();
+
+		REQUIRE(tree.getSize() == 0);
+		REQUIRE(tree.isEmpty() == true);
+	}
+}
+
+TEST_CASE("BPlusTree Insert, Min, Max, GetElementsInRange")
+{
+	SECTION("BPlusTree_Insert_GivenElement_Insert")
+	{
+		BPlusTree tree;
+		vector<RecordPtr> vec;
+		for (int i = 0; i < 100; i++)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+		vec = tree.getElementsInRange(tree.min(), tree.max());
+
+		REQUIRE(tree.getSize() == 100);
+		REQUIRE(tree.isEmpty() == false);
+		REQUIRE(tree.min() == 0);
+		REQUIRE(tree.max() == 99);
+
+		for (int i = 0; i < 100; i++)
+		{
+			REQUIRE(vec[i] == RecordPtr(i, i));
+		}
+	}
+}
+
+TEST_CASE("BPlusTree InsertBatch")
+{
+	SECTION("BPlusTree_InsertBatch_GivenUnsortedElements_Inserts")
+	{
+		BPlusTree tree(3);
+		for (int i = 0; i < 50; i += 2)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+
+		vector<BPlusTree::Kvp> batch;
+		for (int i = 99; i >= 1; i -= 2)
+		{
+			batch.push_back({ Data(i), RecordPtr(i,i) });
+		}
+		tree.insertBatch(batch);
+
+		vector<RecordPtr> vec = tree.getElementsInRange(tree.min(), tree.max());
+
+		REQUIRE(tree.getSize() == 75);
+		REQUIRE(tree.min() == 0);
+		REQUIRE(tree.max() == 99);
+		for (int i = 0; i < 50; i++)
+		{
+			REQUIRE(vec[i] == RecordPtr(i, i));
+		}
+		for (int i = 1; i < 100; i += 2)
+		{
+			REQUIRE(tree.find(Data(i)));
+		}
+	}
+}
+
+TEST_CASE("BPlusTree BulkLoad")
+{
+	SECTION("BPlusTree_BulkLoad_GivenSortedElements_Builds")
+	{
+		BPlusTree tree(3);
+		vector<BPlusTree::Kvp> elements;
+		for (int i = 0; i < 100; i++)
+		{
+			elements.push_back({ Data(i), RecordPtr(i,i) });
+		}
+		tree.bulkLoad(elements, 1.0);
+
+		REQUIRE(tree.getSize() == 100);
+		REQUIRE(tree.min() == 0);
+		REQUIRE(tree.max() == 99);
+		for (int i = 0; i < 100; i++)
+		{
+			REQUIRE(tree.find(Data(i)));
+		}
+
+		for (int i = 0; i < 100; i++)
+		{
+			tree.remove({ Data(i), RecordPtr(i,i) });
+		}
+		REQUIRE(tree.isEmpty() == true);
+	}
+	SECTION("BPlusTree_Deserialize_Rebuilds")
+	{
+		BPlusTree tree;
+		for (int i = 0; i < 100; i++)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+
+		TestFiles testFiles({ "tree_test.bin" });
+		std::ofstream out("tree_test.bin", std::ios::binary);
+		tree.serialize(out);
+		out.close();
+
+		std::ifstream in("tree_test.bin", std::ios::binary);
+		BPlusTree loaded(in);
+		in.close();
+
+		vector<RecordPtr> vec = loaded.getElementsInRange(loaded.min(), loaded.max());
+		REQUIRE(loaded.getSize() == 100);
+		for (int i = 0; i < 100; i++)
+		{
+			REQUIRE(vec[i] == RecordPtr(i, i));
+		}
+	}
+}
+
+TEST_CASE("BPlusTree Remove")
+{
+	SECTION("BPlusTree_Remove_GivenElement_Remove")
+	{
+		BPlusTree tree(3);
+		for (int i = 0; i < 100; i++)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+
+		tree.remove({ Data(5), RecordPtr(5,5) });
+
+		REQUIRE(tree.getSize() == 99);
+
+		for (int i = 0; i < 5; i++)
+		{
+			tree.remove({ Data(i), RecordPtr(i,i) });
+		}
+		for (int i = 6; i < 100; i++)
+		{
+			tree.remove({ Data(i), RecordPtr(i,i) });
+		}
+
+		REQUIRE(tree.getSize() == 0);
+		REQUIRE(tree.isEmpty() == true);
+	}
+}
+
+TEST_CASE("BPlusTree Find")
+{
+	SECTION("BPlusTree_Find_GivenElement_Finds")
+	{
+		BPlusTree tree(3);
+		for (int i = 0; i < 100; i++)
+		{
+			tree.insert({ Data(i), RecordPtr(i,i) });
+		}
+
+		for (int i = 0; i < 100; i++)
+		{
+			REQUIRE(tree.find(Data(i)));
+		}
+	}
+}
+
+TEST_CASE("BPlusTree Range")
+{
+	BPlusTree tree(3);
+	for (int i = 0; i < 100; i++)
+		tree.insert({ Data(i * 2), RecordPtr(i, 0) });
+
+	SECTION("BPlusTree_Range_GivenClosedBounds_WalksRange")
+	{
+		vector<int> values;
+		for (BPlusTree::Cursor cursor = tree.range(Data(10), Data(20)); cursor.isValid(); ++cursor)
+			values.push_back(cursor->first.toInteger());
+
+		REQUIRE(values == vector<int>{ 10, 12, 14, 16, 18, 20 });
+	}
+	SECTION("BPlusTree_Range_GivenOpenBounds_LeavesThemOut")
+	{
+		vector<int> values;
+		for (BPlusTree::Cursor cursor = tree.range(Data(10), Data(20), false, false); cursor.isValid(); ++cursor)
+			values.push_back(cursor->first.toInteger());
+
+		REQUIRE(values == vector<int>{ 12, 14, 16, 18 });
+	}
+	SECTION("BPlusTree_Range_Reverse_WalksBackwards")
+	{
+		vector<int> values;
+		for (BPlusTree::Cursor cursor = tree.range(Data(9), Data(19), true, true, true); cursor.isValid(); ++cursor)
+			values.push_back(cursor->first.toInteger());
+
+		REQUIRE(values == vector<int>{ 18, 16, 14, 12, 10 });
+	}
+	SECTION("BPlusTree_Range_GivenNoBounds_WalksAll")
+	{
+		size_t count = 0;
+		for (BPlusTree::Cursor cursor = tree.range(); cursor.isValid(); ++cursor)
+			count++;
+
+		REQUIRE(count == 100);
+		REQUIRE((*tree.range(Data(), Data(), true, true, true)).first == Data(198));
+		REQUIRE(!tree.range(Data(500)).isValid());
+		REQUIRE(!BPlusTree().range(Data(), Data(), true, true, true).isValid());
+	}
+}
+
+TEST_CASE("Sort Methods", "[Sort]")
+{
+	SECTION("Sort_SortEntries_GivenThreads_SortsParts")
+	{
+		// the rows are split between more threads than cores, so the parts are merged in pieces
+		size_t threads = ThreadPool::i().getThreadCount();
+		ThreadPool::i().setThreadCount(4);
+
+		vector<SortEntry> entries(3 * MIN_ROWS_PER_SORT_TASK + 5);
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			entries[i].row.addColumn(Data((int)(i * 7919 % 100)));
+			entries[i].row.addColumn(Data((int)(entries.size() - i)));
+		}
+		Sort::sortEntries(entries, { { 0, true }, { 1, false } });
+
+		bool ordered = true;
+		for (size_t i = 1; i < entries.size(); i++)
+		{
+			int prev = entries[i - 1].row.getColData(0).toInteger();
+			int curr = entries[i].row.getColData(0).toInteger();
+			ordered = ordered && (prev > curr
+				|| (prev == curr && entries[i - 1].row.getColData(1) < entries[i].row.getColData(1)));
+		}
+		REQUIRE(ordered);
+		REQUIRE(entries.front().row.getColData(0).toInteger() == 99);
+
+		ThreadPool::i().setThreadCount(threads);
+		REQUIRE_THROWS(ThreadPool::i().setThreadCount(0));
+	}
+	SECTION("ThreadPool_Run_GivenThrowingTask_Throws")
+	{
+		vector<size_t> done(8, 0);
+		vector<function<void()>> tasks;
+		for (size_t i = 0; i < done.size(); i++)
+			tasks.push_back([&done, i]() { done[i] = i + 1; });
+		ThreadPool::i().run(tasks);
+		REQUIRE(done[7] == 8);
+
+		tasks.push_back([]() { throw std::invalid_argument("task"); });
+		REQUIRE_THROWS(ThreadPool::i().run(tasks));
+	}
+}
+
+TEST_CASE("BufferPool Methods", "[BufferPool]")
+{
+	TestFiles testFiles({ "ImportTest_page1.bin", "ImportTest_page2.bin" }, { "PoolTest", "ImportTest" });
+
+	SECTION("BufferPool_EvictedDirtyPage_WritesBack")
+	{
+		BufferPool::i().setCapacity(1);
+
+		Page p(3);
+		Record r;
+		r.addColumn(Data(5));
+		p.addRecord(r);
+		BufferPool::i().putPage("PoolTest", 1, p);
+		BufferPool::i().putPage("PoolTest", 2, Page(3));
+
+		REQUIRE(BufferPool::i().size() == 1);
+		REQUIRE(BufferPool::i().getPage("PoolTest", 1).getRecord(0).getColData(0) == 5);
+
+		BufferPool::i().discard("PoolTest");
+		BufferPool::i().setCapacity(DEFAULT_POOL_CAPACITY);
+
+		REQUIRE(BufferPool::i().size() == 0);
+	}
+	SECTION("BufferPool_GivenMissingPage_Throws")
+	{
+		REQUIRE_THROWS(BufferPool::i().getPage("PoolTest", 100));
+	}
+	SECTION("BufferPool_GivenPagesInOldFiles_MovesThemToSegment")
+	{
+		for (int i = 1; i <= 2; i++)
+		{
+			Page p(3);
+			Record r;
+			r.addColumn(Data(i));
+			p.addRecord(r);
+
+			std::ofstream out("ImportTest_page" + std::to_string(i) + ".bin", std::ios::binary);
+			p.serialize(out);
+		}
+
+		REQUIRE(BufferPool::i().importPages("ImportTest", 2, PAGE_SIZE) == PAGE_SIZE);
+		REQUIRE(BufferPool::i().getPage("ImportTest", 2).getRecord(0).getColData(0) == 2);
+		REQUIRE(BufferPool::i().getPage("ImportTest", 1).getRecord(0).getColData(0) == 1);
+		REQUIRE_FALSE(std::ifstream("ImportTest_page1.bin"));
+
+		std::ifstream segment("ImportTest_pages.bin", std::ios::binary | std::ios::ate);
+		REQUIRE((size_t)segment.tellg() == 2 * PAGE_SIZE);
+
+		BufferPool::i().closeSegment("ImportTest");
+	}
+}
+
+TEST_CASE("Table Select", "[Table]")
+{
+	TestFiles testFiles({ "SelectTestNew.bin" }, { "SelectTest", "SelectTestBig", "SelectTest_vacuum" });
+	Table table("(ID:Int, Name:String, Money:Double, Seq:Int)", "SelectTest", "ID");
+	vector<string> rows;
+	for (int i = 1; i <= 1000; i++)
+	{
+		rows.push_back("(" + std::to_string(i) + ", \"Name" + std::to_string(i % 10) + "\", " + std::to_string(i % 20) + ".5, "
+			+ std::to_string(i) + ")");
+	}
+	table.insert(rows);
+
+	vector<string> selected;
+	auto sink = [&](const string& row) { selected.push_back(row); };
+
+	SECTION("Table_Select_GivenIndexedAndResidualConjuncts_Filters")
+	{
+		REQUIRE(table.select("Money > 10 AND ID <= 40 AND Name != \"Name2\"", "", false, "ID", sink) == 18);
+		REQUIRE(selected.front() == "10");
+		REQUIRE(selected.back() == "39");
+	}
+	SECTION("Table_Select_GivenIndexedConjunct_ReadsOnlyItsPages")
+	{
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		REQUIRE(table.select("ID == 55 AND Money > 10", "", false, "Name", sink) == 1);
+		REQUIRE(selected[0] == "\"Name5\"");
+		REQUIRE(BufferPool::i().size() == cached + 1);
+	}
+	SECTION("Table_Select_GivenRangeOnUnindexedColumn_SkipsPages")
+	{
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		// the rows are in the pages in the order of Seq, so only the last page can have rows with Seq > 990
+		REQUIRE(table.getPageCount() > 2);
+		REQUIRE(table.select("Seq > 990", "", false, "ID", sink) == 10);
+		REQUIRE(BufferPool::i().size() == cached + 1);
+
+		table.remove("Seq <= 15");
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+
+		REQUIRE(table.select("Seq < 25 OR NOT Seq != 1000", "", false, "ID", sink) == 9 + 1);
+		REQUIRE(BufferPool::i().size() == cached + 2);
+	}
+	SECTION("Table_Select_GivenOnlyIndexedColumns_ReadsNoPages")
+	{
+		table.createIndex("Name");
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		REQUIRE(table.select("ID > 990", "", false, "ID", sink) == 10);
+		REQUIRE(selected.front() == "991");
+		REQUIRE(table.select("Name == \"Name1\"", "", false, "ID", sink) == 100);
+		REQUIRE(selected[10] == "1");
+		REQUIRE(selected.back() == "991");
+		REQUIRE(table.select("ID < 40 AND Name == \"Name2\"", "ID", false, "Name", sink) == 4);
+		REQUIRE(selected.back() == "\"Name2\"");
+		REQUIRE(table.count("") == 1000);
+		REQUIRE(table.count("ID > 990 OR Name == \"Name3\"") == 10 + 99);
+
+		// the walk of one index stops after the rows of a LIMIT
+		selected.clear();
+		REQUIRE(table.select("ID == 55", "", false, "ID", sink) == 1);
+		REQUIRE(table.select("", "", false, "Name", sink, 3) == 3);
+		REQUIRE(selected.back() == "\"Name0\"");
+		REQUIRE(BufferPool::i().size() == cached);
+
+		// a whole index isn't walked for a few rows
+		REQUIRE(table.select("ID > 995", "", false, "Name", sink) == 5);
+		REQUIRE(BufferPool::i().size() == cached + 1);
+		BufferPool::i().discard("SelectTest");
+
+		REQUIRE(table.select("ID > 990", "", false, "Seq", sink) == 10);
+		REQUIRE(table.count("ID > 990 AND Seq < 995") == 4);
+		REQUIRE(BufferPool::i().size() == cached + 1);
+	}
+	SECTION("Table_Select_GivenLimit_GivesFirstRowsOfOrder")
+	{
+		// Seq isn't indexed, so its first rows are kept in a heap
+		REQUIRE(table.select("Seq > 500", "Seq", false, "ID", sink, 3) == 3);
+		REQUIRE(selected == vector<string>{ "501", "502", "503" });
+		REQUIRE(table.select("", "Seq", true, "Name", sink, 2) == 2);
+		REQUIRE(selected[3] == "\"Name1\"");
+		REQUIRE(selected[4] == "\"Name2\"");
+		REQUIRE(table.select("", "Seq", false, "ID", sink, 0) == 0);
+
+		// ID is indexed, so the rows are fetched in its order and the fetching stops after the first ones
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		selected.clear();
+		REQUIRE(table.select("Money > 19", "ID", false, "Seq", sink, 4) == 4);
+		REQUIRE(selected == vector<string>{ "19", "39", "59", "79" });
+		REQUIRE(BufferPool::i().size() == cached + 1);
+
+		// the order of the leaves of Name, without reading the pages
+		table.createIndex("Name");
+		selected.clear();
+		REQUIRE(table.select("", "Name", false, "ID", sink, 2) == 2);
+		REQUIRE(selected == vector<string>{ "10", "20" });
+		REQUIRE(table.select("ID < 30", "Name", false, "Name", sink) == 29);
+		REQUIRE(selected[2] == "\"Name0\"");
+		REQUIRE(selected.back() == "\"Name9\"");
+
+		// a few rows are sorted instead of walking the whole index, conditions on Name bound the walk
+		selected.clear();
+		REQUIRE(table.select("ID > 995", "Name", false, "Seq", sink) == 5);
+		REQUIRE(selected == vector<string>{ "1000", "996", "997", "998", "999" });
+		REQUIRE(table.select("Name >= \"Name8\" AND ID > 980", "Name", false, "ID", sink) == 4);
+		REQUIRE(vector<string>(selected.begin() + 5, selected.end()) == vector<string>{ "988", "998", "989", "999" });
+	}
+	SECTION("Table_Select_GivenOrderOfColumns_SortsByAll")
+	{
+		REQUIRE(table.select("ID <= 40", "Money DESC ID", false, "ID", sink) == 40);
+		REQUIRE(vector<string>(selected.begin(), selected.begin() + 3) == vector<string>{ "19", "39", "18" });
+		REQUIRE(selected.back() == "40");
+
+		// a LIMIT keeps the first rows in the same order
+		selected.clear();
+		REQUIRE(table.select("ID <= 40", "Money DESC ID DESC", false, "ID", sink, 3) == 3);
+		REQUIRE(selected == vector<string>{ "39", "19", "38" });
+
+		selected.clear();
+		REQUIRE(table.select("", "Name DESC Seq", true, "Name Seq", sink, 2) == 2);
+		REQUIRE(selected == vector<string>{ "\"Name9\" 9", "\"Name9\" 19" });
+
+		selected.clear();
+		REQUIRE(table.select("ID < 30", "ID DESC", false, "ID", sink) == 29);
+		REQUIRE(selected.front() == "29");
+
+		REQUIRE_THROWS(table.select("", "DESC", false, "ID", sink));
+		REQUIRE_THROWS(table.select("", "ID Other", false, "ID", sink));
+	}
+	SECTION("Table_Select_GivenDistinct_KeepsFirstSeenRows")
+	{
+		REQUIRE(table.select("", "", true, "Name", sink) == 10);
+		REQUIRE(selected.front() == "\"Name1\"");
+		REQUIRE(selected.back() == "\"Name0\"");
+
+		selected.clear();
+		REQUIRE(table.select("ID > 990", "", true, "Name Money", sink) == 10);
+		REQUIRE(selected.front() == "\"Name1\" 11.500");
+
+		// the rows after the first distinct ones aren't read
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		REQUIRE(table.select("", "", true, "Name", sink, 3) == 3);
+		REQUIRE(BufferPool::i().size() == cached + 1);
+
+		// close numbers are equal, so they are one row and one group
+		table.insert({ "(1001, \"Near\", 1.0001, 1001)", "(1002, \"Near\", 1.0002, 1002)" });
+		selected.clear();
+		REQUIRE(table.select("ID > 1000", "", true, "Money", sink) == 1);
+		REQUIRE(selected.front() == "1.000");
+
+		selected.clear();
+		REQUIRE(table.aggregate("ID > 1000", "Money", "Money, COUNT(*)", "", sink) == 1);
+		REQUIRE(selected.front() == "1.000 2");
+	}
+	SECTION("Table_Aggregate_GivenGroupBy_ComputesPerGroup")
+	{
+		REQUIRE(table.aggregate("", "Name", "Name, COUNT(*), SUM(Money), AVG(Money), MIN(Seq), MAX(Seq)", "", sink) == 10);
+		REQUIRE(selected.front() == "\"Name1\" 100 650.000 6.500 1 991");
+
+		selected.clear();
+		REQUIRE(table.aggregate("", "Name", "SUM(Seq) Name", "SUM(Seq) DESC", sink, 1) == 1);
+		REQUIRE(selected.front() == "50500 \"Name0\"");
+
+		selected.clear();
+		REQUIRE(table.aggregate("Seq <= 20", "", "COUNT(*), SUM(Seq)", "", sink) == 1);
+		REQUIRE(selected.front() == "20 210");
+
+		// the aggregates of no rows are given in one row
+		selected.clear();
+		REQUIRE(table.aggregate("ID > 2000", "", "MIN(Money), COUNT(Money)", "", sink) == 1);
+		REQUIRE(selected.front() == "NULL 0");
+
+		REQUIRE_THROWS(table.aggregate("", "", "SUM(Name)", "", sink));
+		REQUIRE_THROWS(table.aggregate("", "", "Name, COUNT(*)", "", sink));
+		REQUIRE_THROWS(table.aggregate("", "", "AVG(*)", "", sink));
+		REQUIRE_THROWS(table.aggregate("", "Name", "Name", "Money", sink));
+	}
+	SECTION("Table_Aggregate_GivenIndexedColumns_ReadsNoPages")
+	{
+		table.createIndex("Name");
+		BufferPool::i().flush("SelectTest");
+		BufferPool::i().discard("SelectTest");
+		size_t cached = BufferPool::i().size();
+
+		REQUIRE(table.aggregate("", "", "COUNT(*), MIN(ID), MAX(Name), COUNT(Name)", "", sink) == 1);
+		REQUIRE(selected.front() == "1000 1 \"Name9\" 1000");
+
+		selected.clear();
+		REQUIRE(table.aggregate("ID > 900", "Name", "Name, COUNT(ID), MAX(ID)", "Name", sink) == 10);
+		REQUIRE(selected.front() == "\"Name0\" 10 1000");
+		REQUIRE(BufferPool::i().size() == cached);
+	}
+	SECTION("Table_Select_GivenSmallSortMemory_MergesRuns")
+	{
+		// a few rows in every run, so the runs are also merged in steps
+		Sort::setMemoryBudget(256);
+
+		REQUIRE(table.select("Seq > 100", "Money", false, "Money Seq", sink) == 900);
+		bool ordered = true;
+		for (size_t i = 1; i < selected.size(); i++)
+			ordered = ordered && std::stod(selected[i - 1]) <= std::stod(selected[i]);
+		REQUIRE(ordered);
+
+		// the runs are in the temporary directory while the rows are given and removed after
+		auto countRuns = []()
+		{
+			size_t runs = 0;
+			for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path()))
+				runs += entry.path().filename().string().rfind("sort_", 0) == 0;
+			return runs;
+		};
+		size_t runsBefore = countRuns();
+		size_t runsDuring = 0;
+		table.select("Seq > 100", "Money", false, "Money Seq", [&](const string&) { if (runsDuring == 0) runsDuring = countRuns(); });
+		REQUIRE(runsDuring > runsBefore);
+		REQUIRE(countRuns() == runsBefore);
+
+		selected.clear();
+		REQUIRE(table.select("", "Seq", true, "Name", sink) == 10);
+		REQUIRE(selected.front() == "\"Name1\"");
+		REQUIRE(selected.back() == "\"Name0\"");
+
+		selected.clear();
+		REQUIRE(table.select("ID > 100", "Money", true, "Money Name", sink) == 20);
+		REQUIRE(selected.front() == "0.500 \"Name0\"");
+
+		// the distinct rows don't fit in memory, so the rows after the first one are left out with sorts
+		selected.clear();
+		REQUIRE(table.select("", "", true, "Name", sink) == 10);
+		REQUIRE(selected[0] == "\"Name1\"");
+		REQUIRE(selected[1] == "\"Name0\"");
+		REQUIRE(selected.back() == "\"Name9\"");
+
+		table.insert({ "(1001, \"Near\", 1.0001, 1001)", "(1002, \"Near\", 1.0002, 1002)" });
+		REQUIRE(table.select("ID > 900", "", true, "Money Name", sink) == 20 + 1);
+		REQUIRE(std::count(selected.begin(), selected.end(), "1.000 \"Near\"") == 1);
+
+		Sort::setMemoryBudget(DEFAULT_SORT_MEMORY);
+		REQUIRE_THROWS(Sort::setMemoryBudget(0));
+	}
+	SECTION("Table_CreateBloomFilter_KeepsResults")
+	{
+		REQUIRE_THROWS(table.createBloomFilter("Money"));
+		REQUIRE_THROWS(table.createBloomFilter("Name", 0));
+
+		table.createBloomFilter("Name", 4);
+		REQUIRE_THROWS(table.createBloomFilter("Name"));
+		REQUIRE(table.select("Name == \"Name3\"", "", false, "ID", sink) == 100);
+		REQUIRE(table.select("Name == \"Other\"", "", false, "ID", sink) == 0);
+		REQUIRE(table.select("NOT Name != \"Name3\" AND Seq < 50", "", false, "ID", sink) == 5);
+
+		// the strings are compared without the case of the letters, so the filters don't skip their pages
+		REQUIRE(table.count("Name == \"name3\"") == 100);
+		REQUIRE(table.count("Name == \"NAME3\" AND Seq < 50") == 5);
+	}
+	SECTION("Table_Select_GivenOrOfIndexedAndNot_ScansAll")
+	{
+		REQUIRE(table.select("(ID < 3 OR Money == 19.5)", "", false, "ID", sink) == 2 + 50);
+	}
+	SECTION("Table_Insert_ReusesSpaceOfRemovedRows")
+	{
+		size_t pages = table.getPageCount();
+		table.remove("Seq <= 300");
+
+		vector<string> newRows;
+		for (int i = 1001; i <= 1300; i++)
+			newRows.push_back("(" + std::to_string(i) + ", \"New\", 0.5, " + std::to_string(i) + ")");
+		table.insert(newRows);
+
+		REQUIRE(table.getPageCount() == pages);
+		REQUIRE(table.select("ID > 1000", "", false, "ID", sink) == 300);
+		REQUIRE(table.select("Name == \"New\"", "", false, "ID", sink) == 300);
+		REQUIRE(table.select("Seq <= 300 OR Seq > 1300", "", false, "ID", sink) == 0);
+		REQUIRE(table.select("Seq > 0", "", false, "ID", sink) == 1000);
+	}
+	SECTION("Table_Vacuum_RewritesPagesDensely")
+	{
+		size_t pages = table.getPageCount();
+		table.remove("Seq <= 500");
+		table.vacuum();
+
+		REQUIRE(table.getPageCount() == pages / 2 + 1);
+		REQUIRE(table.size() == 500);
+		REQUIRE(table.select("ID == 501", "", false, "Seq", sink) == 1);
+		REQUIRE(selected[0] == "501");
+		REQUIRE(table.select("Seq > 990", "", false, "ID", sink) == 10);
+
+		std::ifstream segment("SelectTest_pages.bin", std::ios::binary | std::ios::ate);
+		REQUIRE((size_t)segment.tellg() == table.getPageCount() * PAGE_SIZE);
+
+		// the new pages were written to another segment that was moved over the old one with the table file saved
+		REQUIRE(!std::ifstream("SelectTest_vacuum_pages.bin"));
+		std::ifstream in("SelectTest.bin", std::ios::binary);
+		Table loaded(in);
+		REQUIRE(loaded.getPageCount() == table.getPageCount());
+		REQUIRE(loaded.select("Seq > 990", "", false, "ID", sink) == 10);
+	}
+	SECTION("Table_Vacuum_GivenFailedReplace_KeepsTableFile")
+	{
+		table.serialize();
+		std::ifstream before("SelectTest.bin", std::ios::binary);
+		string saved((std::istreambuf_iterator<char>(before)), std::istreambuf_iterator<char>());
+		before.close();
+
+		// the open segment file is still read, but a directory in its place can't be replaced
+		std::filesystem::remove("SelectTest_pages.bin");
+		std::filesystem::create_directory("SelectTest_pages.bin");
+		table.remove("Seq <= 500");
+		REQUIRE_THROWS(table.vacuum());
+
+		std::ifstream after("SelectTest.bin", std::ios::binary);
+		REQUIRE(string((std::istreambuf_iterator<char>(after)), std::istreambuf_iterator<char>()) == saved);
+		REQUIRE(!std::ifstream("SelectTest.bin.tmp"));
+		REQUIRE(!std::ifstream("SelectTest_vacuum_pages.bin"));
+	}
+	SECTION("Table_Vacuum_GivenIndexedColumn_OrdersRows")
+	{
+		REQUIRE_THROWS(table.vacuum("Seq"));
+		REQUIRE_THROWS(table.vacuum("Other"));
+
+		table.createIndex("Name");
+		table.vacuum("Name");
+
+		REQUIRE(table.select("Seq > 0", "", false, "Name", sink) == 1000);
+		REQUIRE(selected.front() == "\"Name0\"");
+		REQUIRE(selected[99] == "\"Name0\"");
+		REQUIRE(selected.back() == "\"Name9\"");
+		REQUIRE(table.select("Name == \"Name3\" AND ID < 100", "", false, "ID", sink) == 10);
+	}
+	SECTION("Table_Load_GivenNewerFileVersion_Throws")
+	{
+		// a whole table file with only the version after the mark changed
+		table.serialize("SelectTestNew.bin");
+		std::fstream file("SelectTestNew.bin", std::ios::in | std::ios::out | std::ios::binary);
+		uint32_t version = TABLE_FILE_VERSION + 1;
+		file.seekp(sizeof(TABLE_FILE_MARK));
+		file.write((const char*)&version, sizeof(version));
+		file.close();
+
+		std::ifstream in("SelectTestNew.bin", std::ios::binary);
+		REQUIRE_THROWS(Table(in));
+	}
+	SECTION("Table_Pages_AreInOneSegmentFile")
+	{
+		BufferPool::i().flush("SelectTest");
+
+		std::ifstream segment("SelectTest_pages.bin", std::ios::binary | std::ios::ate);
+		REQUIRE((size_t)segment.tellg() == table.getPageCount() * PAGE_SIZE);
+		REQUIRE_FALSE(std::ifstream("SelectTest_page1.bin"));
+	}
+	SECTION("Table_GivenPageSize_FillsPagesByBytes")
+	{
+		Table bigPages("(ID:Int, Name:String, Money:Double, Seq:Int)", "SelectTestBig", "ID", 4 * PAGE_SIZE);
+		bigPages.insert(rows);
+
+		REQUIRE(bigPages.getPageSize() == 4 * PAGE_SIZE);
+		REQUIRE(bigPages.getPageCount() < table.getPageCount());
+		REQUIRE(bigPages.select("Seq > 990", "", false, "ID", sink) == 10);
+		REQUIRE_THROWS(Table("(ID:Int)", "SelectTestBad", "ID", 1000));
+		REQUIRE_THROWS(Table("(ID:Int)", "SelectTestBad", "ID", 2 * MAX_PAGE_SIZE));
+	}
+	SECTION("Table_Select_GivenNotOnIndexedColumn_Complements")
+	{
+		REQUIRE(table.select("NOT ID > 2 AND Name == \"Name1\"", "", false, "ID", sink) == 1);
+	}
+}
+
+// the benchmarks are hidden tests, run with: Tests "[benchmark]"
+// they print their timings and check only that the results are right
+
+const int BENCHMARK_ROWS = 200000;
+
+/// @brief Builds the table of a benchmark, its rows are inserted in batches and its pages are written to the segment
+/// @param name - the name of the table
+/// @param header - the columns of the table, the first one is indexed
+/// @param count - the number of rows
+/// @param row - gives the values of the row with a given number in string format, without the brackets
+/// @return the table
+Table benchmarkTable(const string& name, const string& header, int count, const function<string(int)>& row)
+{
+	const int batch = 1000;
+
+	Table table(header, name, "ID");
+	for (int i = 0; i < count; i += batch)
+	{
+		vector<string> rows;
+		for (int j = i; j < std::min(i + batch, count); j++)
+			rows.push_back("(" + row(j) + ")");
+		table.insert(rows);
+	}
+	BufferPool::i().flush(name);
+
+	return table;
+}
+
+/// @brief Gives the values of a row of the (ID:Int, Name:String, Money:Double) tables of the benchmarks
+/// @param j - the number of the row, its ID
+/// @param moneyValues - the number of different values of Money
+/// @return the values in string format
+string moneyRow(int j, int moneyValues)
+{
+	return std::to_string(j) + ", \"Name" + std::to_string(j % 1000) + "\", " + std::to_string(j % moneyValues) + ".5";
+}
+
+/// @brief Measures the time of a part of a benchmark
+/// @param run - the measured part
+/// @return the time in milliseconds (or in the given unit)
+template <class Unit = std::chrono::milliseconds>
+long long timeOf(const function<void()>& run)
+{
+	auto start = std::chrono::steady_clock::now();
+	run();
+	return std::chrono::duration_cast<Unit>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST_CASE("BPlusTree Benchmark", "[.][benchmark]")
+{
+	const int count = 10000000;
+	const int lookups = 1000000;
+	const int scans = 1000;
+	const int scanLength = 10000;
+
+	vector<int> toFind(lookups);
+	std::mt19937 rng(42);
+	for (int i = 0; i < lookups; i++)
+		toFind[i] = rng() % count;
+
+	for (size_t degree : { (size_t)12, BPlusTree::DEGREE })
+	{
+		BPlusTree tree(degree);
+		vector<BPlusTree::Kvp> elements;
+		elements.reserve(count);
+		for (int i = 0; i < count; i++)
+			elements.push_back({ Data(i), RecordPtr(i / 100, i % 100) });
+		tree.bulkLoad(std::move(elements));
+
+		size_t found = 0;
+		auto lookupTime = timeOf([&]()
+		{
+			for (int i = 0; i < lookups; i++)
+				found += tree.find(Data(toFind[i])) != nullptr;
+		});
+
+		size_t scanned = 0;
+		auto scanTime = timeOf([&]()
+		{
+			for (int i = 0; i < scans; i++)
+				scanned += tree.getElementsInRange(Data(toFind[i]), Data(toFind[i] + scanLength - 1)).size();
+		});
+
+		std::cout << "degree " << degree << ": " << lookups << " lookups in " << lookupTime << " ms, "
+			<< scans << " range scans in " << scanTime << " ms" << std::endl;
+
+		REQUIRE(found == lookups);
+		REQUIRE(scanned > 0);
+	}
+}
+
+TEST_CASE("BPlusTree Scaling Benchmark", "[.][benchmark]")
+{
+	// the time per insert and remove should grow only with the height of the tree
+	for (size_t degree : { (size_t)4, BPlusTree::DEGREE })
+	{
+		for (int count : { 10000, 100000, 1000000 })
+		{
+			vector<int> keys(count);
+			for (int i = 0; i < count; i++)
+				keys[i] = i;
+			std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+
+			BPlusTree tree(degree);
+			auto insertTime = timeOf<std::chrono::nanoseconds>([&]()
+			{
+				for (int i = 0; i < count; i++)
+					tree.insert({ Data(keys[i]), RecordPtr(i / 100, i % 100) });
+			});
+
+			REQUIRE(tree.getSize() == (size_t)count);
+
+			auto removeTime = timeOf<std::chrono::nanoseconds>([&]()
+			{
+				for (int i = 0; i < count; i++)
+					tree.remove({ Data(keys[i]), RecordPtr(i / 100, i % 100) });
+			});
+
+			std::cout << "degree " << degree << ", " << count << " keys: " << insertTime / count << " ns per insert, "
+				<< removeTime / count << " ns per remove" << std::endl;
+
+			REQUIRE(tree.isEmpty());
+		}
+	}
+}
+
+TEST_CASE("Sort Keys Benchmark", "[.][benchmark]")
+{
+	// rows sorted by comparing their values against rows sorted by their keys on 1, 2, 4 ... threads of the pool
+	const size_t count = 1000000;
+	const vector<SortKey> keys{ { 0, true }, { 1, false } };
+
+	vector<SortEntry> rows(count);
+	std::mt19937 gen(17);
+	for (size_t i = 0; i < count; i++)
+	{
+		rows[i].row.addColumn(Data("\"Name" + std::to_string(gen() % 5000) + "\""));
+		rows[i].row.addColumn(Data((int)(gen() % 1000000)));
+	}
+
+	vector<SortEntry> compared = rows;
+	auto compareTime = timeOf([&]()
+	{
+		std::sort(compared.begin(), compared.end(), [&keys](const SortEntry& left, const SortEntry& right)
+		{
+			for (size_t i = 0; i < keys.size(); i++)
+			{
+				int cmp = left.row.getColData(keys[i].colInd).compare(right.row.getColData(keys[i].colInd));
+				if (cmp != 0)
+					return keys[i].descending ? cmp > 0 : cmp < 0;
+			}
+			return false;
+		});
+	});
+	std::cout << count << " rows: sorted by comparing the values in " << compareTime << " ms" << std::endl;
+
+	size_t threads = ThreadPool::i().getThreadCount();
+	for (size_t t = 1; t <= std::max<size_t>(threads, 4); t *= 2)
+	{
+		ThreadPool::i().setThreadCount(t);
+		vector<SortEntry> sorted = rows;
+
+		auto keyTime = timeOf([&]() { Sort::sortEntries(sorted, keys); });
+		std::cout << "  sorted by the keys on " << t << " threads in " << keyTime << " ms" << std::endl;
+
+		REQUIRE(sorted.front().row.getColData(0).toString() == compared.front().row.getColData(0).toString());
+		REQUIRE(sorted.back().row.getColData(1) == compared.back().row.getColData(1));
+	}
+	ThreadPool::i().setThreadCount(threads);
+}
+
+TEST_CASE("Table Scan Benchmark", "[.][benchmark]")
+{
+	// a WHERE on a column without an index is checked for every row of the table
+	TestFiles testFiles({}, { "ScanBenchmark" });
+	Table table = benchmarkTable("ScanBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 100); });
+
+	size_t selected;
+	auto selectTime = timeOf([&]()
+	{
+		selected = table.select("Money > 49 AND (Name == \"Name57\" OR NOT Money < 90)", "", false, "ID", [](const string&) {});
+	});
+	auto removeTime = timeOf([&]() { table.remove("Money >= 98"); });
+
+	std::cout << BENCHMARK_ROWS << " rows: select with WHERE in " << selectTime << " ms, remove with WHERE in "
+		<< removeTime << " ms" << std::endl;
+
+	REQUIRE(selected == BENCHMARK_ROWS / 100 * 10 + BENCHMARK_ROWS / 1000);
+	REQUIRE(table.size() == BENCHMARK_ROWS - BENCHMARK_ROWS / 100 * 2);
+}
+
+TEST_CASE("Table Index Benchmark", "[.][benchmark]")
+{
+	// a WHERE on indexed columns only combines the rows of the indexes with AND, OR and NOT
+	TestFiles testFiles({}, { "IndexBenchmark" });
+	Table table = benchmarkTable("IndexBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 100); });
+	table.createIndex("Money");
+
+	size_t selected;
+	auto selectTime = timeOf([&]()
+	{
+		selected = table.select("ID >= 50000 AND NOT Money < 50 OR ID < 1000 AND Money > 90", "", false, "ID",
+			[](const string&) {});
+	});
+
+	std::cout << BENCHMARK_ROWS << " rows: select on indexed columns in " << selectTime << " ms" << std::endl;
+
+	REQUIRE(selected == (BENCHMARK_ROWS - 50000) / 2 + 1000 / 10);
+}
+
+TEST_CASE("Table Zone Map Benchmark", "[.][benchmark]")
+{
+	// a range on an unindexed column that grows with the rows, read from the page files
+	TestFiles testFiles({}, { "ZoneBenchmark" });
+	Table table = benchmarkTable("ZoneBenchmark", "(ID:Int, Money:Double, Seq:Int)", BENCHMARK_ROWS, [](int j)
+	{
+		return std::to_string((j * 7919) % BENCHMARK_ROWS) + ", " + std::to_string(j % 100) + ".5, " + std::to_string(j);
+	});
+	BufferPool::i().discard("ZoneBenchmark");
+
+	size_t selected;
+	auto selectTime = timeOf([&]() { selected = table.select("Seq >= 190000 AND Money > 50", "", false, "ID", [](const string&) {}); });
+
+	std::cout << BENCHMARK_ROWS << " rows: select of the last 5% by an unindexed column in " << selectTime << " ms" << std::endl;
+
+	REQUIRE(selected == (BENCHMARK_ROWS - 190000) / 2);
+}
+
+TEST_CASE("Table Bloom Filter Benchmark", "[.][benchmark]")
+{
+	// an equality on an unindexed column with values in random order, so the zone maps can't skip pages
+	const int count = 100000;
+	const size_t bitsPerKey[] = { 0, 4, 6, 8, 10, 16 };
+	BufferPool::i().setCapacity(count);
+
+	for (size_t bits : bitsPerKey)
+	{
+		string name = "BloomBenchmark" + std::to_string(bits);
+		TestFiles testFiles({}, { name });
+		Table table = benchmarkTable(name, "(ID:Int, Name:String)", count,
+			[](int j) { return std::to_string(j) + ", \"N" + std::to_string((j * 7919LL) % count) + "\""; });
+		if (bits > 0)
+			table.createBloomFilter("Name", bits);
+		BufferPool::i().discard(name);
+		size_t cached = BufferPool::i().size();
+
+		size_t selected = 0;
+		size_t pagesRead = 0;
+		auto selectTime = timeOf([&]()
+		{
+			for (int k = 0; k < 20; k++)
+			{
+				selected += table.select("Name == \"N" + std::to_string(k * 4999) + "\"", "", false, "ID", [](const string&) {});
+				pagesRead += BufferPool::i().size() - cached;
+				BufferPool::i().discard(name);
+			}
+		});
+
+		// every value is in one page, the other pages that were read are false positives
+		size_t pages = table.getPageCount();
+		std::cout << bits << " bits per key: " << pagesRead / 20 << " of " << pages << " pages read per lookup ("
+			<< (double)(pagesRead - 20) / 20 / (pages - 1) * 100 << "% of the pages without the value), 20 lookups in "
+			<< selectTime << " ms" << std::endl;
+
+		REQUIRE(selected == 20);
+	}
+
+	BufferPool::i().setCapacity(DEFAULT_POOL_CAPACITY);
+}
+
+TEST_CASE("Table Churn Benchmark", "[.][benchmark]")
+{
+	// rows are removed and inserted again and again, the table keeps its size only if the space of removed rows is reused
+	const int count = 50000;
+	const int rounds = 10;
+
+	TestFiles testFiles({}, { "ChurnBenchmark" });
+	Table table = benchmarkTable("ChurnBenchmark", "(ID:Int, Name:String, Money:Double)", count,
+		[](int j) { return moneyRow(j, 100); });
+	size_t pages = table.getPageCount();
+
+	auto churnTime = timeOf([&]()
+	{
+		for (int i = 0; i < rounds; i++)
+		{
+			table.remove("Money < 50");
+
+			vector<string> rows;
+			for (int j = 0; j < count / 2; j++)
+			{
+				int id = count * (i + 1) + j;
+				rows.push_back("(" + std::to_string(id) + ", \"Name" + std::to_string(id % 1000) + "\", " + std::to_string(j % 50) + ".5)");
+			}
+			table.insert(rows);
+		}
+	});
+
+	size_t selected;
+	auto selectTime = timeOf([&]() { selected = table.select("Name == \"Name57\"", "", false, "ID", [](const string&) {}); });
+
+	std::cout << count << " rows, " << rounds << " rounds of removing and inserting half of them in " << churnTime
+		<< " ms, pages " << pages << " -> " << table.getPageCount() << ", select with WHERE in " << selectTime << " ms" << std::endl;
+
+	REQUIRE(table.size() == count);
+	REQUIRE(selected == count / 1000 + count / 2 / 1000);
+}
+
+TEST_CASE("Table Vacuum Benchmark", "[.][benchmark]")
+{
+	// after most rows are removed a scan still reads every page, until the table is written again into fewer pages
+	TestFiles testFiles({}, { "VacuumBenchmark" });
+	Table table = benchmarkTable("VacuumBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 100); });
+	table.remove("Money < 90");
+	size_t pages = table.getPageCount();
+
+	size_t before, after;
+	auto beforeTime = timeOf([&]() { before = table.select("Money == 95.5", "", false, "ID", [](const string&) {}); });
+	auto vacuumTime = timeOf([&]() { table.vacuum(); });
+	auto afterTime = timeOf([&]() { after = table.select("Money == 95.5", "", false, "ID", [](const string&) {}); });
+
+	std::cout << BENCHMARK_ROWS / 10 << " of " << BENCHMARK_ROWS << " rows left: select with WHERE in " << beforeTime
+		<< " ms on " << pages << " pages, vacuum in " << vacuumTime << " ms, select with WHERE in " << afterTime
+		<< " ms on " << table.getPageCount() << " pages" << std::endl;
+
+	REQUIRE(before == BENCHMARK_ROWS / 100);
+	REQUIRE(after == BENCHMARK_ROWS / 100);
+	REQUIRE(table.size() == BENCHMARK_ROWS / 10);
+}
+
+TEST_CASE("Table Index Only Benchmark", "[.][benchmark]")
+{
+	// a select of indexed columns only is answered from the leaves of the indexes without reading the pages
+	TestFiles testFiles({}, { "IndexOnlyBenchmark" });
+	Table table = benchmarkTable("IndexOnlyBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 100); });
+	BufferPool::i().discard("IndexOnlyBenchmark");
+
+	size_t selected, counted, point, limited;
+	auto selectTime = timeOf([&]() { selected = table.select("ID >= 100000", "", false, "ID", [](const string&) {}); });
+	auto countTime = timeOf([&]() { counted = table.count("ID >= 100000"); });
+
+	// the walk starts at the bounds of the condition and stops after the rows of a LIMIT
+	auto pointTime = timeOf<std::chrono::microseconds>([&]() { point = table.select("ID == 5", "", false, "ID", [](const string&) {}); });
+	auto limitTime = timeOf<std::chrono::microseconds>([&]() { limited = table.select("", "", false, "ID", [](const string&) {}, 10); });
+
+	std::cout << BENCHMARK_ROWS << " rows: select of an indexed column in " << selectTime << " ms, count in " << countTime
+		<< " ms, one value in " << pointTime << " us, the first 10 in " << limitTime << " us" << std::endl;
+
+	REQUIRE(selected == BENCHMARK_ROWS / 2);
+	REQUIRE(counted == BENCHMARK_ROWS / 2);
+	REQUIRE(point == 1);
+	REQUIRE(limited == 10);
+}
+
+TEST_CASE("Table Top K Benchmark", "[.][benchmark]")
+{
+	// the first rows of an order are kept in a bounded heap, or fetched in the order of an index
+	const size_t limit = 100;
+
+	TestFiles testFiles({}, { "TopKBenchmark" });
+	Table table = benchmarkTable("TopKBenchmark", "(ID:Int, Name:String, Seq:Int)", BENCHMARK_ROWS, [](int j)
+	{
+		return std::to_string(j) + ", \"Name" + std::to_string(j % 1000) + "\", " + std::to_string((j * 7919) % BENCHMARK_ROWS);
+	});
+
+	size_t sorted, topK, indexed, indexedLimit;
+	auto sortTime = timeOf([&]() { sorted = table.select("", "Seq", false, "ID Name Seq", [](const string&) {}); });
+	auto topKTime = timeOf([&]() { topK = table.select("", "Seq", false, "ID Name Seq", [](const string&) {}, limit); });
+	auto indexTime = timeOf([&]() { indexed = table.select("", "ID", false, "ID Name Seq", [](const string&) {}); });
+	auto indexLimitTime = timeOf([&]() { indexedLimit = table.select("", "ID", false, "ID Name Seq", [](const string&) {}, limit); });
+
+	// a few rows ordered by an indexed column
+	table.createIndex("Name");
+	size_t few;
+	auto fewTime = timeOf<std::chrono::microseconds>([&]()
+	{
+		for (int j = 0; j < 100; j++)
+			few = table.select("ID < 10", "Name", false, "ID Name Seq", [](const string&) {});
+	}) / 100;
+
+	std::cout << BENCHMARK_ROWS << " rows: ORDER BY an unindexed column in " << sortTime << " ms, with LIMIT " << limit << " in "
+		<< topKTime << " ms; ORDER BY an indexed column in " << indexTime << " ms, with LIMIT " << limit << " in "
+		<< indexLimitTime << " ms; 10 rows ORDER BY an indexed column in " << fewTime << " us" << std::endl;
+
+	REQUIRE(sorted == BENCHMARK_ROWS);
+	REQUIRE(topK == limit);
+	REQUIRE(indexed == BENCHMARK_ROWS);
+	REQUIRE(indexedLimit == limit);
+	REQUIRE(few == 10);
+}
+
+TEST_CASE("Table External Sort Benchmark", "[.][benchmark]")
+{
+	// the rows of an ORDER BY are sorted in memory or written to sorted runs and merged when they don't fit
+	TestFiles testFiles({}, { "ExternalSortBenchmark" });
+	Table table = benchmarkTable("ExternalSortBenchmark", "(ID:Int, Name:String, Seq:Int)", BENCHMARK_ROWS, [](int j)
+	{
+		return std::to_string(j) + ", \"Name" + std::to_string(j % 1000) + "\", " + std::to_string((j * 7919) % BENCHMARK_ROWS);
+	});
+
+	auto measure = [&](size_t memory, bool distinct, size_t& selected)
+	{
+		Sort::setMemoryBudget(memory);
+		return timeOf([&]() { selected = table.select("", "Seq", distinct, distinct ? "Name" : "ID Name Seq", [](const string&) {}); });
+	};
+
+	size_t inMemory, spilled, distinctInMemory, distinctSpilled;
+	auto inMemoryTime = measure(DEFAULT_SORT_MEMORY, false, inMemory);
+	auto spilledTime = measure(1024 * 1024, false, spilled);
+	auto distinctInMemoryTime = measure(DEFAULT_SORT_MEMORY, true, distinctInMemory);
+	auto distinctSpilledTime = measure(1024 * 1024, true, distinctSpilled);
+	Sort::setMemoryBudget(DEFAULT_SORT_MEMORY);
+
+	std::cout << BENCHMARK_ROWS << " rows: ORDER BY in memory in " << inMemoryTime << " ms, with 1 MiB of memory in "
+		<< spilledTime << " ms; DISTINCT in memory in " << distinctInMemoryTime << " ms, with 1 MiB of memory in "
+		<< distinctSpilledTime << " ms" << std::endl;
+
+	REQUIRE(inMemory == BENCHMARK_ROWS);
+	REQUIRE(spilled == BENCHMARK_ROWS);
+	REQUIRE(distinctInMemory == 1000);
+	REQUIRE(distinctSpilled == 1000);
+}
+
+TEST_CASE("Table Distinct Benchmark", "[.][benchmark]")
+{
+	// the same rows are left out with a hash table of the kept values, the first ones are given without reading the rest
+	TestFiles testFiles({}, { "DistinctBenchmark" });
+	Table table = benchmarkTable("DistinctBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 7); });
+
+	auto measure = [&](const string& toPrint, size_t limit, size_t& selected)
+	{
+		return timeOf([&]() { selected = table.select("", "", true, toPrint, [](const string&) {}, limit); });
+	};
+
+	size_t names, pairs, limited;
+	auto namesTime = measure("Name", NO_LIMIT, names);
+	auto pairsTime = measure("Name Money", NO_LIMIT, pairs);
+	auto limitTime = measure("Name", 10, limited);
+
+	// the kept pairs don't fit in memory, so the rest of the rows are left out with an external sort
+	size_t sortedPairs;
+	Sort::setMemoryBudget(64 * 1024);
+	auto sortedTime = measure("Name Money", NO_LIMIT, sortedPairs);
+	Sort::setMemoryBudget(DEFAULT_SORT_MEMORY);
+
+	std::cout << BENCHMARK_ROWS << " rows: DISTINCT of 1000 names in " << namesTime << " ms, of 7000 pairs in " << pairsTime
+		<< " ms (with 64 KiB of memory in " << sortedTime << " ms), the first 10 names in " << limitTime << " ms" << std::endl;
+
+	REQUIRE(names == 1000);
+	REQUIRE(pairs == 7000);
+	REQUIRE(sortedPairs == 7000);
+	REQUIRE(limited == 10);
+}
+
+TEST_CASE("Table Aggregate Benchmark", "[.][benchmark]")
+{
+	// the groups are built next to the data, compared with selecting every row and adding the values up from the printed rows
+	TestFiles testFiles({}, { "AggregateBenchmark" });
+	Table table = benchmarkTable("AggregateBenchmark", "(ID:Int, Name:String, Money:Double)", BENCHMARK_ROWS,
+		[](int j) { return moneyRow(j, 7); });
+
+	std::unordered_map<string, double> sums;
+	auto selectTime = timeOf([&]()
+	{
+		table.select("", "", false, "Name Money", [&](const string& row)
+		{
+			size_t space = row.rfind(' ');
+			sums[row.substr(0, space)] += std::stod(row.substr(space + 1));
+		});
+	});
+
+	size_t groups;
+	auto groupTime = timeOf([&]()
+	{
+		groups = table.aggregate("", "Name", "Name, COUNT(*), SUM(Money), AVG(Money)", "", [](const string&) {});
+	});
+
+	vector<string> extremes;
+	auto indexTime = timeOf<std::chrono::microseconds>([&]()
+	{
+		table.aggregate("", "", "COUNT(*), MIN(ID), MAX(ID)", "", [&](const string& row) { extremes.push_back(row); });
+	});
+
+	std::cout << BENCHMARK_ROWS << " rows: SUM of 1000 groups from the selected rows in " << selectTime << " ms, with GROUP BY in "
+		<< groupTime << " ms, COUNT, MIN and MAX from the index in " << indexTime << " us" << std::endl;
+
+	REQUIRE(sums.size() == 1000);
+	REQUIRE(groups == 1000);
+	REQUIRE(extremes[0] == std::to_string(BENCHMARK_ROWS) + " 0 " + std::to_string(BENCHMARK_ROWS - 1));
+}
@@ -0,0 +1,104 @@
+#include "ThreadPool.h"
+#include <stdexcept>
+
+ThreadPool::ThreadPool()
+	: unfinished(0)
+	, stopping(false)
+{
+	size_t count = std::thread::hardware_concurrency();
+	start(count == 0 ? 1 : count);
+}
+
+ThreadPool::~ThreadPool()
+{
+	stop();
+}
+
+ThreadPool& ThreadPool::i()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::setThreadCount(size_t count)
+{
+	if (count == 0)
+		throw std::invalid_argument("Thread count must be positive!");
+
+	std::lock_guard<std::mutex> runLock(runMutex);
+	stop();
+	start(count);
+}
+
+void ThreadPool::start(size_t count)
+{
+	stopping = false;
+	for (size_t i = 0; i < count; i++)
+		threads.emplace_back(&ThreadPool::work, this);
+}
+
+void ThreadPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	hasTasks.notify_all();
+
+	for (size_t i = 0; i < threads.size(); i++)
+		threads[i].join();
+	threads.clear();
+}
+
+void ThreadPool::run(const vector<function<void()>>& batch)
+{
+	if (batch.empty())
+		return;
+
+	std::lock_guard<std::mutex> runLock(runMutex);
+	std::unique_lock<std::mutex> lock(mutex);
+
+	error = nullptr;
+	unfinished = batch.size();
+	for (size_t i = 0; i < batch.size(); i++)
+		tasks.push(batch[i]);
+	hasTasks.notify_all();
+
+	batchDone.wait(lock, [this]() { return unfinished == 0; });
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			hasTasks.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (stopping)
+				return;
+
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+
+		std::exception_ptr taskError;
+		try
+		{
+			task();
+		}
+		catch (...)
+		{
+			taskError = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (taskError && !error)
+			error = taskError;
+		if (--unfinished == 0)
+			batchDone.notify_one();
+	}
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using std::function;
+using std::vector;
+
+/// @brief A fixed set of worker threads (one for every core) that run tasks given in batches.
+/// The threads are started once and wait for tasks, so a batch doesn't pay for creating threads.
+
+class ThreadPool
+{
+public:
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+	~ThreadPool();
+
+	static ThreadPool& i();
+
+	/// @brief Runs tasks on the threads of the pool and waits until all of them are done.
+	/// The first exception thrown by a task is thrown again after all tasks are done.
+	/// @param batch - the tasks
+	void run(const vector<function<void()>>& batch);
+
+	/// @brief Stops the threads of the pool and starts a given number of new ones
+	/// @param count - the number of threads
+	void setThreadCount(size_t count);
+
+	/// @brief Gets the number of threads of the pool
+	inline size_t getThreadCount() const { return threads.size(); }
+
+private:
+	ThreadPool();
+
+	/// @brief Starts the threads
+	/// @param count - the number of threads
+	void start(size_t count);
+
+	/// @brief Stops the threads after they finish their tasks
+	void stop();
+
+	/// @brief Takes tasks from the queue and runs them until the pool is destroyed
+	void work();
+
+private:
+	vector<std::thread> threads;
+	std::queue<function<void()>> tasks;
+	size_t unfinished; // the tasks of the current batch that aren't done yet
+	std::exception_ptr error; // the first exception of the current batch
+	bool stopping;
+	std::mutex mutex;
+	std::condition_variable hasTasks;
+	std::condition_variable batchDone;
+	std::mutex runMutex; // lets one batch run at a time
+};
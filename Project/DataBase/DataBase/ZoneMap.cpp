@@ -0,0 +1,88 @@
+#include "ZoneMap.h"
+
+ZoneMap::ZoneMap(size_t columns)
+	: mins(columns)
+	, maxs(columns)
+	, filters(columns)
+	, liveRows(0)
+	, removedRows(0)
+{}
+
+ZoneMap::ZoneMap(std::ifstream& in, bool withFilters)
+{
+	size_t columns;
+	in.read((char*)&columns, sizeof(columns));
+	in.read((char*)&liveRows, sizeof(liveRows));
+	in.read((char*)&removedRows, sizeof(removedRows));
+
+	// the ranges are saved only if a row was added to the page
+	uint8_t hasRanges;
+	in.read((char*)&hasRanges, sizeof(hasRanges));
+
+	mins.resize(columns);
+	maxs.resize(columns);
+	for (size_t i = 0; hasRanges && i < columns; i++)
+	{
+		mins[i] = Data(in);
+		maxs[i] = Data(in);
+	}
+
+	filters.resize(columns);
+	for (size_t i = 0; withFilters && i < columns; i++)
+		filters[i] = BloomFilter(in);
+}
+
+void ZoneMap::add(const Record& record)
+{
+	for (size_t i = 0; i < mins.size(); i++)
+	{
+		const Data& value = record.getColData(i);
+		if (mins[i].isNull() || value < mins[i])
+			mins[i] = value;
+		if (maxs[i].isNull() || value > maxs[i])
+			maxs[i] = value;
+
+		filters[i].add(value);
+	}
+
+	liveRows++;
+}
+
+void ZoneMap::clear()
+{
+	for (size_t i = 0; i < mins.size(); i++)
+	{
+		mins[i] = Data();
+		maxs[i] = Data();
+		filters[i].clear();
+	}
+
+	liveRows = 0;
+	removedRows = 0;
+}
+
+void ZoneMap::enableFilter(size_t col, size_t keys, size_t bitsPerKey)
+{
+	filters[col] = BloomFilter(keys, bitsPerKey);
+}
+
+void ZoneMap::serialize(std::ofstream& out) const
+{
+	size_t columns = mins.size();
+	out.write((const char*)&columns, sizeof(columns));
+	out.write((const char*)&liveRows, sizeof(liveRows));
+	out.write((const char*)&removedRows, sizeof(removedRows));
+
+	uint8_t hasRanges = columns > 0 && !mins[0].isNull();
+	out.write((const char*)&hasRanges, sizeof(hasRanges));
+
+	for (size_t i = 0; hasRanges && i < columns; i++)
+	{
+		mins[i].serialize(out);
+		maxs[i].serialize(out);
+	}
+
+	for (size_t i = 0; i < columns; i++)
+		filters[i].serialize(out);
+}
+
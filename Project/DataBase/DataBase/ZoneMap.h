@@ -0,0 +1,71 @@
+#pragma once
+#include "BloomFilter.h"
+#include "Record.h"
+#include <fstream>
+#include <vector>
+
+using std::vector;
+
+/// @brief A summary of one page of a table - the smallest and the biggest value of every column,
+/// the number of live and removed rows and a Bloom filter of the columns that have one.
+/// It is kept next to the table, so a scan can tell that no row of a page can match a condition
+/// without reading the page.
+
+class ZoneMap
+{
+public:
+	/// @brief Creates the summary of an empty page
+	/// @param columns - the number of columns of the table
+	ZoneMap(size_t columns = 0);
+
+	/// @brief Deserializing constructor
+	/// @param in - the file that the object will be read from
+	/// @param withFilters - false if the summary was saved before it had Bloom filters
+	ZoneMap(std::ifstream& in, bool withFilters = true);
+
+	/// @brief Widens the ranges of the columns with the values of a row added to the page
+	/// @param record - the row
+	void add(const Record& record);
+
+	/// @brief Counts a removed row (an empty slot) of the page
+	inline void addRemoved() { removedRows++; }
+
+	/// @brief Stops counting a removed row whose slot got a new row (the new row is added with add)
+	inline void reuseRemoved() { removedRows--; }
+
+	/// @brief Clears the ranges, the counts and the filters, so the summary can be built again from the slots of the page
+	void clear();
+
+	/// @brief Adds an empty Bloom filter to a column (its values have to be added again)
+	/// @param col - the index of the column
+	/// @param keys - the max number of rows of the page
+	/// @param bitsPerKey - the bits of the filter for every row
+	void enableFilter(size_t col, size_t keys, size_t bitsPerKey);
+
+	/// @brief Gets the Bloom filter of a column (disabled if the column has no filter)
+	inline const BloomFilter& getFilter(size_t col) const { return filters[col]; }
+
+	inline const Data& getMin(size_t col) const { return mins[col]; }
+
+	inline const Data& getMax(size_t col) const { return maxs[col]; }
+
+	inline size_t getLiveRows() const { return liveRows; }
+
+	inline size_t getRemovedRows() const { return removedRows; }
+
+	/// @brief Checks if the page has no live rows
+	/// @return true if all rows of the page are removed (or it has none) and false otherwise
+	inline bool isEmpty() const { return liveRows == 0; }
+
+	/// @brief Saves the summary to a file in binary format
+	/// @param out - the file
+	void serialize(std::ofstream& out) const;
+
+private:
+	vector<Data> mins;
+	vector<Data> maxs;
+	vector<BloomFilter> filters;
+	size_t liveRows;
+	size_t removedRows;
+};
+